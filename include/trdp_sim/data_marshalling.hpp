@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "data_types.hpp"
@@ -12,6 +13,12 @@ namespace trdp_sim::util
 
     std::size_t elementSize(const data::ElementDef& def, const EngineContext& ctx);
 
+    // Returns nullptr when a nested dataset is missing or nests too deeply (e.g. a cycle).
+    std::shared_ptr<const data::MarshalPlan> compileMarshalPlan(const data::DataSetDef& def, const EngineContext& ctx);
+
+    // Attach a compiled plan to every dataset instance in the context.
+    void compileMarshalPlans(EngineContext& ctx);
+
     std::vector<uint8_t> marshalDataSet(const data::DataSetInstance& inst, const EngineContext& ctx);
 
     void unmarshalDataToDataSet(data::DataSetInstance& inst, const EngineContext& ctx, const uint8_t* data,
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -45,6 +47,33 @@ namespace data
         std::vector<ElementDef> elements;
     };
 
+    /**
+     * Wire layout of a dataset, compiled once per DataSetDef. `slots` has one
+     * entry per top-level element (one ValueCell each), nested datasets
+     * taking their expanded size.
+     */
+    struct MarshalPlan
+    {
+        struct Field
+        {
+            std::size_t offset{0};
+            std::size_t size{0}; // bytes for the whole array
+            ElementType type{ElementType::UINT8};
+            uint32_t    arraySize{1};
+        };
+
+        std::vector<Field> slots;
+        std::size_t        totalSize{0};
+    };
+
+    // Immutable published image of a contiguous dataset.
+    struct DataSetSnapshot
+    {
+        uint64_t              generation{0};
+        std::vector<uint8_t>  bytes;
+        std::vector<uint64_t> definedBits;
+    };
+
     struct ValueCell
     {
         bool                 defined{false};
@@ -53,11 +82,66 @@ namespace data
 
     struct DataSetInstance
     {
-        const DataSetDef*      def{nullptr};
-        std::vector<ValueCell> values;
+        const DataSetDef*                  def{nullptr};
+        std::shared_ptr<const MarshalPlan> plan; // optional; legacy per-element sizing when unset
+        std::vector<ValueCell>             values;
         bool                   locked{false};
         bool                   isOutgoing{false};
         mutable std::mutex     mtx;
+
+        // Contiguous layout (see enableContiguousStorage): the wire image laid out by
+        // `plan`, with undefined elements kept zeroed, plus one defined bit per element.
+        // `values` is empty while it is in use.
+        std::vector<uint8_t>  buffer;
+        std::vector<uint64_t> definedBits;
+        bool                  contiguous{false};
+
+        // Writers edit `buffer` under mtx (the back buffer) and publish a copy as a new
+        // generation; readers take the front snapshot without mtx via publishedSnapshot().
+        // `front` is the snapshot in `published`; `spare` is the one it replaced, refilled by
+        // the next publish once no reader holds it. All three are guarded by mtx.
+        std::shared_ptr<const DataSetSnapshot> published;
+        std::shared_ptr<DataSetSnapshot>       front;
+        std::shared_ptr<DataSetSnapshot>       spare;
+        uint32_t                               publishDeferred{0}; // open DataSetWriteBatch scopes
+        bool                                   publishPending{false};
+
+        // Bumped by markModified() on every mutation, in either layout; guarded by mtx.
+        uint64_t generation{0};
     };
 
+    // Element accessors that work with either instance layout. Callers hold inst.mtx.
+    std::size_t          elementCount(const DataSetInstance& inst);
+    bool                 isElementDefined(const DataSetInstance& inst, std::size_t idx);
+    std::vector<uint8_t> elementBytes(const DataSetInstance& inst, std::size_t idx);
+    void                 setElementBytes(DataSetInstance& inst, std::size_t idx, const uint8_t* bytes, std::size_t len);
+    void                 clearElement(DataSetInstance& inst, std::size_t idx);
+    void                 zeroAllElements(DataSetInstance& inst); // undefined, zero-filled at full size
+
+    // Latest published image without taking inst.mtx (the shared_ptr atomics may still use the
+    // standard library's internal lock); nullptr for the per-cell layout.
+    std::shared_ptr<const DataSetSnapshot> publishedSnapshot(const DataSetInstance& inst);
+
+    // Start a new generation after a mutation and publish it for contiguous instances, unless a
+    // DataSetWriteBatch is open. Callers hold inst.mtx; the mutating accessors call it themselves.
+    void markModified(DataSetInstance& inst);
+
+    // Defers publication while in scope, so a multi-element update publishes one snapshot when
+    // the outermost batch closes. Held under inst.mtx.
+    class DataSetWriteBatch
+    {
+      public:
+        explicit DataSetWriteBatch(DataSetInstance& inst);
+        ~DataSetWriteBatch();
+        DataSetWriteBatch(const DataSetWriteBatch&)            = delete;
+        DataSetWriteBatch& operator=(const DataSetWriteBatch&) = delete;
+
+      private:
+        DataSetInstance& m_inst;
+    };
+
+    // Switch an instance to the contiguous layout, carrying over current values.
+    // Requires a compiled plan; returns false (layout unchanged) otherwise.
+    bool enableContiguousStorage(DataSetInstance& inst);
+
 } // namespace data
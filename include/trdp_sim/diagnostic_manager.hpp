@@ -61,6 +61,40 @@ namespace diag
         bool trdpThreadRunning{false};
     };
 
+    struct PdShardMetrics
+    {
+        std::size_t index{0};
+        std::size_t publishers{0};
+        uint64_t    sends{0};
+        uint64_t    sendErrors{0};
+        uint64_t    passes{0};
+        double      maxPassUs{0.0};
+        uint64_t    maxSendsPerPass{0};
+        double      wakeupLatencyMaxUs{0.0};
+    };
+
+    struct PdRxRingMetrics
+    {
+        std::size_t channel{0};
+        std::string interfaceName;
+        std::size_t capacity{0};
+        std::size_t occupancy{0};
+        std::size_t highWater{0};
+        uint64_t    enqueued{0};
+        uint64_t    overflows{0};
+    };
+
+    // Percentiles of a merged latency histogram, in microseconds.
+    struct LatencyPercentiles
+    {
+        uint64_t samples{0};
+        double   p50Us{0.0};
+        double   p90Us{0.0};
+        double   p99Us{0.0};
+        double   p999Us{0.0};
+        double   maxUs{0.0};
+    };
+
     struct PdMetrics
     {
         std::size_t telegrams{0};
@@ -73,6 +107,19 @@ namespace diag
         uint64_t    stressBursts{0};
         uint64_t    redundancySwitches{0};
         uint64_t    busFailureDrops{0};
+        uint64_t    missedCycles{0};
+        double      maxLatenessUs{0.0};
+        LatencyPercentiles cycleJitter{}; // all telegrams, see PdTelegramRuntime::jitterHist
+        uint64_t    payloadCacheHits{0};
+        uint64_t    coalescedFrames{0}; // received frames superseded before being decoded
+        uint64_t    payloadCacheMisses{0};
+        double      stressTargetRate{0.0};   // sum of paced publisher targets (telegrams/s)
+        double      stressAchievedRate{0.0};
+        bool        realtimeThread{false};
+        double      wakeupLatencyMeanUs{0.0};
+        double      wakeupLatencyMaxUs{0.0};
+        std::vector<PdShardMetrics>           shards;
+        std::vector<PdRxRingMetrics>          rxRings; // receive handoff, one per interface session
         std::chrono::system_clock::time_point latestRxWall{};
         std::chrono::system_clock::time_point latestTxWall{};
     };
@@ -85,6 +132,7 @@ namespace diag
         uint64_t    retryCount{0};
         uint64_t    timeoutCount{0};
         double      maxLatencyUs{0.0};
+        LatencyPercentiles roundTrip{};
     };
 
     struct TrdpMetrics
@@ -141,6 +189,8 @@ namespace diag
 
         void log(Severity sev, const std::string& component, const std::string& message,
                  const std::optional<std::string>& extraJson = std::nullopt);
+        // Lock-free; lets hot paths skip building event payloads that would be filtered out.
+        bool shouldLog(Severity sev) const;
 
         std::vector<Event> fetchRecent(std::size_t maxEvents);
         std::vector<Event> fetchSince(const std::chrono::system_clock::time_point& since, std::size_t maxEvents);
@@ -160,7 +210,6 @@ namespace diag
         void        rotateLogIfNeeded();
         void        persistEvent(const Event& ev);
         void        pollMetrics();
-        bool        shouldLog(Severity sev) const;
         std::string severityToString(Severity sev) const;
         std::string formatTimestamp(const std::chrono::system_clock::time_point& tp) const;
         bool        ensurePcapFileUnlocked(std::size_t nextPacketSize);
@@ -177,6 +226,7 @@ namespace diag
 
         LogConfig             m_logCfg{};
         mutable std::mutex    m_logCfgMtx;
+        std::atomic<int>      m_minSeverity{0}; // mirrors m_logCfg.minimumSeverity
         std::filesystem::path m_logPath;
         std::ofstream         m_logFile;
 
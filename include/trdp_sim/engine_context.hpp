@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -64,6 +66,30 @@ namespace trdp_sim
             double   lossRate{0.0};
         };
 
+        // Immutable rule tables; a new version is published for every edit.
+        struct InjectionRuleSet
+        {
+            uint64_t                                    version{0};
+            std::unordered_map<uint32_t, InjectionRule> pdRules;
+            std::unordered_map<uint32_t, InjectionRule> mdRules;
+            std::unordered_map<uint32_t, InjectionRule> dataSetRules;
+        };
+
+        // Rule resolved for one telegram or session, valid while `version` is current.
+        struct CachedInjectionRule
+        {
+            std::shared_ptr<const InjectionRuleSet> rules; // keeps `rule` alive
+            const InjectionRule*                    rule{nullptr};
+            uint64_t                                version{0};
+        };
+
+        // Paced PD traffic in telegrams/s; a COM ID target wins over its interface's.
+        struct PdRateTargets
+        {
+            std::unordered_map<uint32_t, double>    perComId;
+            std::unordered_map<std::string, double> perInterface; // shared by the interface's publishers
+        };
+
         struct StressMode
         {
             bool     enabled{false};
@@ -71,9 +97,12 @@ namespace trdp_sim
             uint32_t pdBurstTelegrams{0};
             uint32_t mdBurst{0};
             uint32_t mdIntervalUs{0};
+            // Immutable once published, so stress snapshots stay cheap to copy.
+            std::shared_ptr<const PdRateTargets> pdRates;
 
             static constexpr std::size_t kMaxBurstTelegrams = 1000;
             static constexpr uint32_t    kMinCycleUs       = 1000;
+            static constexpr double      kMaxRatePerSecond = 100000.0;
         };
 
         struct RedundancySimulation
@@ -96,15 +125,22 @@ namespace trdp_sim
             cfg::DeviceConfig  config;
         };
 
+        // Current rules for the TX/RX paths without taking mtx (the shared_ptr atomics may
+        // still use the standard library's internal lock).
+        std::shared_ptr<const InjectionRuleSet> injectionRules() const;
+        // Replace the rules with `next` as a new version. Callers hold mtx.
+        void publishInjectionRules(InjectionRuleSet next);
+
         mutable std::mutex                                 mtx;
-        std::unordered_map<uint32_t, InjectionRule>        pdRules;
-        std::unordered_map<uint32_t, InjectionRule>        mdRules;
-        std::unordered_map<uint32_t, InjectionRule>        dataSetRules;
+        std::atomic<uint64_t>                              rulesVersion{0};
         StressMode                                         stress;
         RedundancySimulation                               redundancy;
         TimeSyncOffsets                                    timeSync;
         std::unordered_map<std::string, VirtualInstance>   instances;
         std::string                                        activeInstance;
+
+      private:
+        std::shared_ptr<const InjectionRuleSet> m_rules{std::make_shared<InjectionRuleSet>()};
     };
 
     struct PdRuntimeDeleter
@@ -133,6 +169,8 @@ namespace trdp_sim
 
         // PD telegrams
         std::vector<std::unique_ptr<pd::PdTelegramRuntime, PdRuntimeDeleter>> pdTelegrams;
+        // Subscriber runtimes by COM ID for receive dispatch; rebuilt with pdTelegrams.
+        std::unordered_map<uint32_t, std::vector<pd::PdTelegramRuntime*>> pdSubscribersByComId;
 
         // MD sessions (sessionId → runtime)
         std::unordered_map<uint32_t, std::unique_ptr<md::MdSessionRuntime, MdSessionDeleter>> mdSessions;
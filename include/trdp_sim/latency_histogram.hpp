@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace trdp_sim::util
+{
+
+    /**
+     * Fixed-memory log-linear histogram of microsecond samples. Values below
+     * 16 us are exact; above that every power of two is split into 16 linear
+     * buckets, so any recorded value is reported within ~6 %. record() only
+     * touches relaxed atomics and may run on the hot path while pollers take
+     * snapshots concurrently.
+     */
+    class LatencyHistogram
+    {
+      public:
+        static constexpr unsigned    kSubBucketBits = 4;
+        static constexpr uint64_t    kSubBuckets    = uint64_t{1} << kSubBucketBits;
+        static constexpr unsigned    kMaxExponent   = 31; // larger samples land in the top bucket
+        static constexpr std::size_t kBuckets       = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+        // Plain copy of the counters; snapshots from many histograms merge into one.
+        struct Snapshot
+        {
+            std::array<uint64_t, kBuckets> counts{};
+            uint64_t                       samples{0};
+            uint64_t                       maxUs{0};
+
+            void merge(const Snapshot& other);
+
+            // Upper bound of the bucket holding the q-quantile (0..1), capped at maxUs.
+            double percentile(double q) const;
+        };
+
+        LatencyHistogram() = default;
+        LatencyHistogram(const LatencyHistogram&)            = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        void     record(uint64_t valueUs);
+        Snapshot snapshot() const;
+        void     reset();
+
+        static std::size_t bucketFor(uint64_t valueUs);
+        static uint64_t    bucketUpperBound(std::size_t index);
+
+      private:
+        std::array<std::atomic<uint64_t>, kBuckets> m_counts{};
+        std::atomic<uint64_t>                       m_maxUs{0};
+    };
+
+} // namespace trdp_sim::util
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <optional>
@@ -10,6 +12,9 @@
 #include <vector>
 
 #include "engine_context.hpp"
+#include "latency_histogram.hpp"
+#include "release_queue.hpp"
+#include "timer_wheel.hpp"
 
 namespace trdp_sim::trdp
 {
@@ -42,12 +47,21 @@ namespace engine::md
         ERROR
     };
 
+    // A dispatch held back by TCP pacing until the MD thread releases it.
+    enum class MdPendingDispatch
+    {
+        NONE,
+        REQUEST,
+        REPLY
+    };
+
     struct MdRuntimeStats
     {
         uint64_t                              txCount{0};
         uint64_t                              rxCount{0};
         uint64_t                              retryCount{0};
         uint64_t                              timeoutCount{0};
+        uint64_t                              pacedDispatches{0}; // deferred by TCP pacing
         uint64_t                              lastRoundTripUs{0};
         std::chrono::steady_clock::time_point lastTxTime{};
         std::chrono::steady_clock::time_point lastRxTime{};
@@ -76,6 +90,9 @@ namespace engine::md
         MdSessionState                        state{MdSessionState::IDLE};
         uint32_t                              retryCount{0};
         TRDP_UUID_T                           trdpSessionId{};
+        TRDP_APP_SESSION_T                    appSession{nullptr}; // of iface, cached by TrdpAdapter
+        uint64_t                              appSessionEpoch{0};
+        MdPendingDispatch                     pendingDispatch{MdPendingDispatch::NONE};
         std::chrono::steady_clock::time_point lastStateChange{};
         std::chrono::steady_clock::time_point deadline{};
         std::chrono::steady_clock::time_point lastRequestWall{};
@@ -83,6 +100,8 @@ namespace engine::md
         std::vector<uint8_t>                  lastRequestPayload;
         std::vector<uint8_t>                  lastResponsePayload;
         MdRuntimeStats                        stats{};
+        trdp_sim::SimulationControls::CachedInjectionRule injection; // guarded by mtx
+        trdp_sim::util::LatencyHistogram      roundTripHist;
         std::mutex                            mtx;
     };
 
@@ -116,12 +135,27 @@ namespace engine::md
         }
 
       private:
+        // TRDP_UUID_T may be a plain array; the index keys on a copy of its bytes.
+        using UuidKey = std::array<uint8_t, sizeof(TRDP_UUID_T)>;
+        struct UuidKeyHash
+        {
+            std::size_t operator()(const UuidKey& key) const;
+        };
+
         void buildSessionsFromConfig();
         void runLoop();
-        void handleTimeouts();
+        void handleTimeouts(std::chrono::steady_clock::time_point now);
+        void armDeadlineLocked(const MdSessionRuntime& session);
+        void armTimer(uint64_t id, std::chrono::steady_clock::time_point due);
+        bool deferTcpDispatchLocked(MdSessionRuntime& session, MdPendingDispatch kind);
+        void runPendingDispatch(uint32_t sessionId);
         std::optional<MdSessionRuntime*> getSessionByTrdpSession(const TRDP_UUID_T& trdpSessionId);
+        void indexTrdpSession(const MdSessionRuntime& session, const UuidKey& previous);
+        void deliverIndication(const TRDP_MD_INFO_T* info, const uint8_t* data, std::size_t len);
         void dispatchRequestLocked(MdSessionRuntime& session);
         void dispatchReplyLocked(MdSessionRuntime& session);
+        void sendRequestPayloadLocked(MdSessionRuntime& session, const std::vector<uint8_t>& payload);
+        void sendReplyPayloadLocked(MdSessionRuntime& session, const std::vector<uint8_t>& payload);
 
         trdp_sim::EngineContext&     m_ctx;
         trdp_sim::trdp::TrdpAdapter& m_adapter;
@@ -129,8 +163,22 @@ namespace engine::md
         std::mutex                                      m_sessionsMtx;
         std::unordered_map<uint32_t, MdTelegramBinding> m_telegramByComId;
         uint32_t                                        m_nextSessionId{1};
+        // TRDP session UUID -> session id for indications. Its own lock, taken last, so it can be
+        // updated while a session's mtx is held.
+        std::mutex                                                m_uuidMtx;
+        std::unordered_map<UuidKey, uint32_t, UuidKeyHash>        m_sessionByUuid;
         std::atomic<bool>                               m_running{false};
         std::thread                                     m_thread; // Optional MD handling loop
+
+        // Reply/confirm deadlines by session id and paced dispatches, served by the MD thread. Taken
+        // after a session's mtx.
+        std::mutex                                      m_timerMtx;
+        std::condition_variable                         m_timerCv;
+        trdp_sim::util::TimerWheel                      m_timers;
+        // When the sleeping MD thread wakes next; only an earlier timer needs to notify it. Set to
+        // time_point::min() while the thread is awake, since it reads the wheel before sleeping.
+        std::chrono::steady_clock::time_point           m_timerWakeAt{std::chrono::steady_clock::time_point::min()};
+        trdp_sim::util::ReleaseQueue                    m_release; // delayed sends/receives from injection rules
     };
 
 } // namespace engine::md
@@ -2,13 +2,22 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "config_manager.hpp"
 #include "data_types.hpp"
 #include "engine_context.hpp"
+#include "latency_histogram.hpp"
+#include "pd_scheduler.hpp"
+#include "release_queue.hpp"
+#include "spsc_frame_ring.hpp"
 
 namespace trdp_sim::trdp
 {
@@ -27,12 +36,20 @@ namespace engine::pd
     struct PdRuntimeStats
     {
         uint64_t                              txCount{0};
+        uint64_t                              txErrors{0}; // sends rejected by the stack
         uint64_t                              rxCount{0};
         uint64_t                              timeoutCount{0};
         uint64_t                              lastSeqNumber{0};
         uint64_t                              stressBursts{0};
         uint64_t                              busFailureDrops{0};
         uint64_t                              redundancySwitches{0};
+        uint64_t                              missedCycles{0};
+        double                                maxLatenessUs{0.0};
+        uint64_t                              payloadCacheHits{0};
+        uint64_t                              payloadCacheMisses{0};
+        uint64_t                              pacedSends{0}; // since pacing was last configured
+        uint64_t                              decodes{0};         // frames applied to the dataset
+        uint64_t                              coalescedFrames{0}; // replaced in the mailbox before decoding
         std::chrono::steady_clock::time_point lastTxTime{};
         std::chrono::steady_clock::time_point lastRxTime{};
         double                                lastCycleJitterUs{0.0};
@@ -61,44 +78,262 @@ namespace engine::pd
         uint32_t                          activeChannel{0};
         std::vector<PublicationChannel>   pubChannels;
         TRDP_SUB_T                        subHandle{nullptr};
+        // Session of ifaceCfg, cached by TrdpAdapter for the TX path; guarded by mtx.
+        TRDP_APP_SESSION_T                appSession{nullptr};
+        uint64_t                          appSessionEpoch{0};
         bool                              sendNow{false};
+        std::chrono::steady_clock::time_point nextDue{}; // cycle slot the next send belongs to
+        std::size_t                       shard{0};
+        uint64_t                          schedToken{0}; // guarded by the owning shard's lock
+        bool                              timeoutArmed{false}; // subscriber has a live timeout deadline
+        std::size_t                       ifacePublisherIndex{0}; // position among the interface's publishers
+        std::size_t                       ifacePublisherCount{1};
+        PdTokenBucket                     pacing; // active while a stress rate target applies
+        std::chrono::steady_clock::time_point pacingStart{};
+        // Last marshalled payload and the dataset generation it was built from.
+        std::vector<uint8_t>              cachedPayload;
+        uint64_t                          cachedGeneration{0};
+        bool                              payloadCached{false};
+        std::vector<uint8_t>              txScratch; // reused for corrupted payloads, keeps its capacity
+        trdp_sim::SimulationControls::CachedInjectionRule injection; // guarded by mtx
+        // Latest received frame not yet decoded into the dataset (decode rate set), guarded by mtx.
+        std::vector<uint8_t>              mailbox;
+        bool                              mailboxPending{false};
+        bool                              mailboxArmed{false}; // a flush is queued on the shard
+        std::chrono::steady_clock::time_point lastDecode{};
+        // Cycle jitter: receive interarrival deviation for subscribers, send lateness for publishers.
+        trdp_sim::util::LatencyHistogram  jitterHist;
         std::mutex                        mtx;
     };
 
+    struct PdTimingConfig
+    {
+        enum class CycleMode
+        {
+            RELATIVE, // next send is one cycle after the previous one went out
+            ABSOLUTE  // next send is one cycle after the previous slot, free of drift
+        };
+
+        enum class CatchUpPolicy
+        {
+            SKIP,  // slots that have already passed are dropped
+            BURST  // passed slots are sent back-to-back until caught up
+        };
+
+        // Initial phase of publishers sharing an interface and cycle; applied on initializeFromConfig().
+        enum class Phasing
+        {
+            ALIGNED,       // all start on the same tick
+            STAGGER,       // spread evenly across the cycle in COM ID order
+            OFFSET_ADDRESS // STAGGER, but a non-zero offsetAddress is taken as the phase in microseconds
+        };
+
+        CycleMode     mode{CycleMode::RELATIVE};
+        CatchUpPolicy catchUp{CatchUpPolicy::SKIP};
+        uint32_t      maxBurstCycles{8}; // BURST only; older slots are skipped beyond this
+        Phasing       phasing{Phasing::STAGGER};
+    };
+
+    /**
+     * Opt-in real-time publisher thread. Priority and tick come from the
+     * TrdpProcess settings of the configured interfaces (highest priority,
+     * shortest non-zero cycleTimeUs); failures to apply a setting are logged
+     * and the thread keeps running with what it has.
+     */
+    struct PdRealtimeConfig
+    {
+        bool               enabled{false};
+        std::optional<int> cpu{};          // pin the publisher thread to this CPU
+        bool               lockMemory{true}; // mlockall(MCL_CURRENT | MCL_FUTURE)
+    };
+
+    struct PdWakeupStats
+    {
+        bool     realtime{false}; // SCHED_FIFO was applied to the publisher thread
+        uint64_t samples{0};
+        double   lastUs{0.0};
+        double   meanUs{0.0};
+        double   maxUs{0.0};
+    };
+
+    /**
+     * Publishers are split across worker threads, each with its own scheduler,
+     * so a slow send only stalls its own shard. A single
+     * worker reproduces the classic one-thread engine. Applied on the next
+     * initializeFromConfig().
+     */
+    struct PdShardingConfig
+    {
+        enum class Partition
+        {
+            INTERFACE,  // one shard per bus interface (modulo workers)
+            COMID_HASH  // spread COM IDs evenly regardless of interface
+        };
+
+        Partition   partition{Partition::INTERFACE};
+        std::size_t workers{1}; // 0 = one per interface (INTERFACE) or per hardware thread (COMID_HASH)
+    };
+
+    struct PdShardStats
+    {
+        std::size_t   index{0};
+        std::size_t   publishers{0};
+        uint64_t      sends{0};
+        uint64_t      sendErrors{0};
+        uint64_t      passes{0};
+        double        maxPassUs{0.0}; // longest scheduling pass
+        uint64_t      maxSendsPerPass{0}; // largest number of telegrams sent on one tick
+        PdWakeupStats wakeup{};
+    };
+
+    struct PdRateStats
+    {
+        uint32_t    comId{0};
+        std::string interfaceName;
+        double      targetPerSecond{0.0};
+        double      achievedPerSecond{0.0};
+    };
+
+    /**
+     * Received PD frames are copied into a preallocated ring per interface
+     * session and applied to the datasets by an RX worker, so the TRDP I/O
+     * thread only pays for a copy. Without the worker (handoff off or engine
+     * stopped) frames are processed on the caller's thread. Applied on the
+     * next initializeFromConfig().
+     */
+    struct PdRxConfig
+    {
+        bool        handoff{true};
+        std::size_t ringSlots{1024}; // per interface, rounded up to a power of two
+        // Subscribers keep only their latest frame and decode it into the dataset at most this often,
+        // or when the dataset is read. 0 decodes every frame. Takes effect immediately.
+        double      decodeRateHz{0.0};
+    };
+
+    struct PdRxStats
+    {
+        std::size_t                          channel{0};
+        std::string                          interfaceName;
+        trdp_sim::util::SpscFrameRing::Stats ring{};
+    };
+
     class PdEngine
     {
       public:
         PdEngine(trdp_sim::EngineContext& ctx, trdp_sim::trdp::TrdpAdapter& adapter);
         ~PdEngine();
 
-        void initializeFromConfig(bool activateTransport);
+        void initializeFromConfig(bool activateTransport = true);
         void start();
         void stop();
 
         void enableTelegram(uint32_t comId, bool enable);
         void triggerSendNow(uint32_t comId);
 
-        // Dataset access:
+        // Dataset access; decodes any frame still waiting in the subscribers' mailboxes first.
         data::DataSetInstance* getDataSetInstance(uint32_t dataSetId);
+        void                   syncDataSet(uint32_t dataSetId);
 
-        // Called from TRDP adapter:
-        void onPdReceived(uint32_t comId, const uint8_t* data, std::size_t len);
+        // Called from TRDP adapter. rxChannel is the receiving interface session; each channel
+        // must be fed by a single thread.
+        void onPdReceived(uint32_t comId, const uint8_t* data, std::size_t len, std::size_t rxChannel = 0);
 
         // Exposed for deterministic scheduling tests and single-tick processing
         void processPublishersOnce(std::chrono::steady_clock::time_point now);
 
+        void           setTimingConfig(const PdTimingConfig& cfg);
+        PdTimingConfig timingConfig() const;
+
+        // Takes effect on the next start().
+        void             setRealtimeConfig(const PdRealtimeConfig& cfg);
+        PdRealtimeConfig realtimeConfig() const;
+
+        void             setShardingConfig(const PdShardingConfig& cfg);
+        PdShardingConfig shardingConfig() const;
+
+        void       setRxConfig(const PdRxConfig& cfg);
+        PdRxConfig rxConfig() const;
+
+        // Timed-sleep overshoot of the publisher threads (actual minus requested wakeup).
+        PdWakeupStats             wakeupStats() const;
+        std::vector<PdShardStats> shardStats() const;
+        // Publishers currently paced by a stress rate target.
+        std::vector<PdRateStats> rateStats() const;
+        std::vector<PdRxStats>   rxStats() const;
+
+        // Re-read simulation controls (stress cycle override) and wake the publisher thread.
+        void reschedule();
+
         bool isRunning() const
         {
             return m_running.load();
         }
 
       private:
-        void runPublisherLoop();
+        struct Shard
+        {
+            std::size_t                     index{0};
+            std::vector<PdTelegramRuntime*> publishers;
+            std::mutex                      mtx; // guards everything below
+            std::condition_variable         cv;
+            PdScheduler                     scheduler;
+            PdScheduler                     timeouts; // subscriber deadlines (last rx + timeoutUs)
+            // Min-heap of mailbox decode deadlines, at most one per subscriber (see mailboxArmed).
+            std::vector<std::pair<std::chrono::steady_clock::time_point, PdTelegramRuntime*>> mailboxFlushes;
+            bool                            kick{false};
+            uint32_t                        appliedCycleOverrideUs{0};
+            std::shared_ptr<const trdp_sim::SimulationControls::PdRateTargets> appliedRates;
+            PdShardStats                    stats;
+            std::thread                     thread;
+        };
+
+        void        runShardLoop(Shard& shard);
+        void        processShardOnce(Shard& shard, std::chrono::steady_clock::time_point now);
+        void        expireSubscribers(Shard& shard, std::chrono::steady_clock::time_point now);
+        void        flushDueMailboxes(Shard& shard, std::chrono::steady_clock::time_point now);
+        void        armMailboxFlush(PdTelegramRuntime& pd, std::chrono::steady_clock::time_point due);
+        void        rearmShardLocked(Shard& shard, std::chrono::steady_clock::time_point now, uint32_t cycleOverrideUs,
+                                     const std::shared_ptr<const trdp_sim::SimulationControls::PdRateTargets>& rates);
+        void        wake(Shard& shard);
+        void        wakeAll();
+        std::size_t shardCountFor(const config::DeviceConfig& cfg) const;
+        bool        applyRealtimeSettings(const Shard& shard);
+        void        processReceived(uint32_t comId, const uint8_t* data, std::size_t len,
+                                    std::chrono::steady_clock::time_point rxTime);
+        void        deliverReceived(uint32_t comId, const uint8_t* data, std::size_t len,
+                                    const trdp_sim::SimulationControls::InjectionRule* baseRule,
+                                    std::chrono::steady_clock::time_point rxTime);
+        void        decodeLocked(PdTelegramRuntime& pd, const uint8_t* data, std::size_t len);
+        void        flushMailboxLocked(PdTelegramRuntime& pd, std::chrono::steady_clock::time_point now);
+        void        startRxWorker();
+        void        stopRxWorker();
+        void        runRxLoop();
+        std::size_t drainRx();
+        void        releaseDelayedSend(PdTelegramRuntime& pd, const std::vector<uint8_t>& payload);
 
         trdp_sim::EngineContext&     m_ctx;
         trdp_sim::trdp::TrdpAdapter& m_adapter;
         std::atomic<bool>            m_running{false};
-        std::thread                  m_thread;
+
+        std::vector<std::unique_ptr<Shard>> m_shards;
+        std::chrono::microseconds           m_realtimeTick{1000};
+        trdp_sim::util::ReleaseQueue        m_release; // delayed sends/receives from injection rules
+
+        std::unordered_map<uint32_t, std::vector<PdTelegramRuntime*>> m_subscribersByDataSet;
+        std::atomic<int64_t>                m_decodeIntervalUs{0}; // from PdRxConfig::decodeRateHz
+
+        std::vector<std::unique_ptr<trdp_sim::util::SpscFrameRing>> m_rxRings; // one per interface session
+        std::atomic<bool>                   m_rxRunning{false};
+        std::atomic<bool>                   m_rxIdle{false}; // worker is about to sleep; producers notify
+        std::mutex                          m_rxMtx;
+        std::condition_variable             m_rxCv;
+        std::thread                         m_rxThread;
+
+        mutable std::mutex m_cfgMtx; // guards the settings below
+        PdTimingConfig     m_timing{};
+        PdRealtimeConfig   m_realtime{};
+        PdShardingConfig   m_sharding{};
+        PdRxConfig         m_rx{};
     };
 
 } // namespace engine::pd
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace engine::pd
+{
+
+    struct PdTelegramRuntime;
+
+    /**
+     * Deadline-ordered index of PD publishers. Each runtime owns at most one
+     * live entry; re-arming a runtime invalidates its previous entry lazily so
+     * updates stay O(log N) without searching the heap. Entries due at the same
+     * instant pop in ascending COM ID order to keep the send order deterministic.
+     *
+     * The scheduler is not synchronized; the owning engine guards it.
+     */
+    class PdScheduler
+    {
+      public:
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        struct Entry
+        {
+            TimePoint          due{};
+            uint32_t           comId{0};
+            uint64_t           token{0};
+            PdTelegramRuntime* pd{nullptr};
+        };
+
+        void clear();
+
+        // Schedule (or reschedule) a runtime; any earlier entry for it is discarded.
+        void arm(PdTelegramRuntime& pd, TimePoint due);
+
+        // Drop the runtime from the schedule until it is armed again.
+        void disarm(PdTelegramRuntime& pd);
+
+        // Pop the earliest live entry if it is due at or before `now`.
+        bool popDue(TimePoint now, Entry& out);
+
+        // Pop the earliest live entry regardless of its deadline.
+        bool popNext(Entry& out);
+
+        std::optional<TimePoint> nextDue();
+        bool                     isArmed(const PdTelegramRuntime& pd) const;
+        std::size_t              armedCount() const { return m_live; }
+
+      private:
+        struct Later
+        {
+            bool operator()(const Entry& a, const Entry& b) const
+            {
+                if (a.due != b.due)
+                    return a.due > b.due;
+                return a.comId > b.comId;
+            }
+        };
+
+        bool isLive(const Entry& e) const;
+        void dropStale();
+
+        std::vector<Entry> m_heap;
+        uint64_t           m_nextToken{1};
+        std::size_t        m_live{0};
+    };
+
+    /**
+     * Token bucket pacing one publisher at a target rate. Each release is
+     * scheduled one interval after the previous one, so a late wakeup shortens
+     * the next gap instead of losing credit; a stall of a full interval or more
+     * restarts the schedule at `now`, which keeps the depth at one and stops it
+     * from turning into a burst. The scheduler arms the publisher for
+     * nextRelease() to spread sends evenly over time. A phase in [0, 1) delays
+     * the first token by that fraction of the interval so peers sharing a rate
+     * interleave.
+     */
+    class PdTokenBucket
+    {
+      public:
+        using TimePoint = PdScheduler::TimePoint;
+
+        void   configure(double ratePerSecond, TimePoint now, double phase = 0.0);
+        void   reset() { m_rate = 0.0; }
+        bool   active() const { return m_rate > 0.0; }
+        double rate() const { return m_rate; }
+
+        // Spend the token for the release due at or before `now`, if any.
+        bool      tryConsume(TimePoint now);
+        TimePoint nextRelease(TimePoint now) const;
+
+      private:
+        TimePoint due() const;
+
+        double    m_rate{0.0};
+        TimePoint m_origin{};
+        double    m_offset{0.0}; // seconds from m_origin to the next release, kept unrounded
+    };
+
+} // namespace engine::pd
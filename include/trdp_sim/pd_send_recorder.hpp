@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace trdp_sim::trdp
+{
+
+    struct PdSendLogEntry
+    {
+        uint32_t comId{0};
+        uint32_t channel{0};
+        bool     dropped{false};
+    };
+
+    /**
+     * Opt-in record of PD transmissions for tests and troubleshooting: the
+     * last kCapacity send attempts in a fixed ring plus the last payload sent.
+     * While disabled every hook is a single relaxed load, so the production
+     * send path neither allocates nor takes a lock here.
+     */
+    class PdSendRecorder
+    {
+      public:
+        static constexpr std::size_t kCapacity = 64;
+
+        void setEnabled(bool enable) { m_enabled.store(enable, std::memory_order_relaxed); }
+        bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+        void recordAttempt(uint32_t comId, uint32_t channel, bool dropped);
+        void recordPayload(const uint8_t* data, std::size_t len);
+        void clear();
+
+        std::vector<PdSendLogEntry> entries() const; // oldest first
+        std::vector<uint8_t>        lastPayload() const;
+
+      private:
+        std::atomic<bool>                     m_enabled{false};
+        mutable std::mutex                    m_mtx;
+        std::array<PdSendLogEntry, kCapacity> m_ring{};
+        std::size_t                           m_next{0};
+        std::size_t                           m_size{0};
+        std::vector<uint8_t>                  m_lastPayload; // capacity is kept across sends
+    };
+
+} // namespace trdp_sim::trdp
@@ -7,6 +7,16 @@
 #include <string>
 #include <vector>
 
+namespace trdp_sim
+{
+    struct EngineContext;
+} // namespace trdp_sim
+
+namespace engine::pd
+{
+    class PdEngine;
+}
+
 namespace trdp_sim::perf
 {
 
@@ -59,5 +69,54 @@ namespace trdp_sim::perf
         std::optional<TimePoint> m_lastWebUpdate;
     };
 
+    struct SaturationConfig
+    {
+        Platform                  platform{Platform::VM};
+        Thresholds                thresholds{};
+        std::chrono::milliseconds settleTime{100};   // after each load change, before measuring
+        std::chrono::milliseconds stepDuration{500}; // measurement window per step
+        std::size_t               maxSteps{24};
+        double                    minDeliveryRatio{0.9}; // achieved/offered below this counts as saturated
+    };
+
+    struct SaturationStep
+    {
+        uint32_t cycleOverrideUs{0};
+        uint32_t burstTelegrams{0};
+        double   offeredPerSecond{0.0}; // estimated from cycles and burst budget
+        double   achievedPerSecond{0.0};
+        double   maxJitterMicros{0.0}; // worst publisher lateness in the window
+        uint64_t txErrors{0};          // PD send errors of this interface's publishers
+        bool     sustained{false};
+    };
+
+    struct InterfaceSaturation
+    {
+        std::string                 name;
+        std::size_t                 publishers{0};
+        double                      maxSustainablePerSecond{0.0};
+        bool                        saturated{false}; // false if the ramp ran out before a limit was hit
+        std::vector<SaturationStep> steps;
+    };
+
+    struct SaturationReport
+    {
+        Platform                         platform{Platform::VM};
+        std::vector<InterfaceSaturation> interfaces;
+
+        std::string toJson() const;
+    };
+
+    /**
+     * Closed-loop PD capacity probe. Ramps stress mode (cycle override down to
+     * the minimum cycle, then the per-tick burst budget up to its cap) on the
+     * running publisher threads and measures each step. An interface is
+     * saturated once jitter or its publishers' TX errors cross the thresholds or
+     * fewer than minDeliveryRatio of the offered telegrams go out. Its
+     * capacity is the best achieved rate of a sustained step. The previous
+     * stress settings and run state are restored afterwards.
+     */
+    SaturationReport runPdSaturation(EngineContext& ctx, engine::pd::PdEngine& pd, const SaturationConfig& cfg = {});
+
 } // namespace trdp_sim::perf
 
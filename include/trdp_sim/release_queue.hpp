@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trdp_sim::util
+{
+
+    /**
+     * Timestamp-ordered queue of deferred actions, drained by a worker thread
+     * that is started on first use. Injected latency parks a send or receive
+     * here instead of sleeping on the caller's thread, so only the targeted
+     * telegram is held back. Actions due at the same instant run in the order
+     * they were scheduled.
+     */
+    class ReleaseQueue
+    {
+      public:
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+        using Action    = std::function<void()>;
+
+        ReleaseQueue() = default;
+        ~ReleaseQueue();
+        ReleaseQueue(const ReleaseQueue&)            = delete;
+        ReleaseQueue& operator=(const ReleaseQueue&) = delete;
+
+        void schedule(TimePoint releaseAt, Action action);
+
+        // Discard pending actions and wait for the one in flight. Actions must
+        // not call stop() themselves.
+        void stop();
+
+        std::size_t pending() const;
+
+      private:
+        struct Item
+        {
+            TimePoint releaseAt{};
+            uint64_t  seq{0};
+            Action    action;
+        };
+
+        struct Later
+        {
+            bool operator()(const Item& a, const Item& b) const
+            {
+                if (a.releaseAt != b.releaseAt)
+                    return a.releaseAt > b.releaseAt;
+                return a.seq > b.seq;
+            }
+        };
+
+        void run();
+
+        mutable std::mutex      m_mtx;
+        std::condition_variable m_cv;
+        std::vector<Item>       m_heap;
+        uint64_t                m_nextSeq{0};
+        bool                    m_stopping{false};
+        std::thread             m_thread;
+    };
+
+} // namespace trdp_sim::util
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace trdp_sim::util
+{
+
+    /**
+     * Bounded single-producer/single-consumer queue of received frames. Slots
+     * are preallocated, so a push is one copy into the next slot and a release
+     * store: it never blocks or allocates. A full ring rejects the frame and
+     * counts an overflow. Exactly one thread may push and one may drain.
+     */
+    class SpscFrameRing
+    {
+      public:
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        static constexpr std::size_t kMaxFrameBytes = 1432; // largest TRDP PD payload
+
+        struct Frame
+        {
+            uint32_t    comId{0};
+            TimePoint   rxTime{};
+            std::size_t len{0};
+            uint8_t     data[kMaxFrameBytes];
+        };
+
+        struct Stats
+        {
+            std::size_t capacity{0};
+            std::size_t occupancy{0};
+            std::size_t highWater{0}; // largest occupancy seen by the producer
+            uint64_t    pushed{0};
+            uint64_t    overflows{0};
+        };
+
+        // The capacity is rounded up to a power of two.
+        explicit SpscFrameRing(std::size_t capacity);
+        SpscFrameRing(const SpscFrameRing&)            = delete;
+        SpscFrameRing& operator=(const SpscFrameRing&) = delete;
+
+        static bool fits(std::size_t len) { return len <= kMaxFrameBytes; }
+
+        // Producer side. False when the ring is full; frames must fit().
+        bool tryPush(uint32_t comId, const uint8_t* data, std::size_t len, TimePoint rxTime);
+
+        // Consumer side: hands up to maxFrames queued frames to fn in arrival order.
+        std::size_t drain(const std::function<void(const Frame&)>& fn,
+                          std::size_t maxFrames = std::numeric_limits<std::size_t>::max());
+
+        bool  empty() const;
+        Stats stats() const;
+
+      private:
+        std::vector<Frame> m_slots;
+        std::size_t        m_mask{0};
+
+        alignas(64) std::atomic<std::size_t> m_head{0}; // next frame to drain, written by the consumer
+        alignas(64) std::atomic<std::size_t> m_tail{0}; // next slot to fill, written by the producer
+        std::atomic<std::size_t> m_highWater{0};
+        std::atomic<uint64_t>    m_overflows{0};
+    };
+
+} // namespace trdp_sim::util
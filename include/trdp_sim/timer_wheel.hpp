@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp_sim::util
+{
+
+    /**
+     * Hashed timing wheel of one-shot timers keyed by id. Deadlines are
+     * rounded up to the next tick, so a timer never fires early and at most
+     * one tick late; timers beyond one revolution wait in their slot until
+     * their round comes up. Re-scheduling an id replaces its previous timer,
+     * which is dropped lazily. expire() only visits the slots that elapsed,
+     * so its cost follows the number of expiring timers, not the armed ones;
+     * nextExpiry() reads a min-heap of armed ticks instead of scanning slots.
+     *
+     * The wheel is not synchronized; the owner guards it.
+     */
+    class TimerWheel
+    {
+      public:
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        explicit TimerWheel(std::chrono::microseconds tick = std::chrono::microseconds(250),
+                            std::size_t slots = 4096, TimePoint origin = Clock::now());
+
+        void schedule(uint64_t id, TimePoint due);
+        void cancel(uint64_t id);
+        void clear();
+
+        // Append the ids of all timers due at or before `now` to `out`, earliest tick first.
+        void expire(TimePoint now, std::vector<uint64_t>& out);
+
+        // Tick time of the earliest armed timer, or nullopt when none is armed. Drops stale
+        // heap entries, hence not const.
+        std::optional<TimePoint> nextExpiry();
+
+        std::size_t                armedCount() const { return m_live.size(); }
+        std::chrono::microseconds  tick() const { return m_tick; }
+
+      private:
+        struct Entry
+        {
+            uint64_t tickIndex{0};
+            uint64_t id{0};
+            uint64_t token{0};
+        };
+
+        struct LaterTick
+        {
+            bool operator()(const Entry& a, const Entry& b) const { return a.tickIndex > b.tickIndex; }
+        };
+
+        bool     isLive(const Entry& e) const;
+        uint64_t tickIndexFor(TimePoint due) const; // rounded up
+
+        std::chrono::microseconds              m_tick;
+        TimePoint                              m_origin;
+        std::vector<std::vector<Entry>>        m_slots;
+        uint64_t                               m_mask{0};
+        uint64_t                               m_current{0}; // ticks before this one have been expired
+        uint64_t                               m_nextToken{1};
+        std::unordered_map<uint64_t, uint64_t> m_live; // id -> token of its armed timer
+        std::vector<Entry>                     m_ticks; // min-heap by tick; replaced/fired entries dropped lazily
+    };
+
+} // namespace trdp_sim::util
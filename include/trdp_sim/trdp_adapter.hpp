@@ -1,15 +1,20 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "engine_context.hpp"
+#include "pd_send_recorder.hpp"
+#include "trdp_event_loop.hpp"
 
 namespace config
 {
@@ -30,18 +35,27 @@ namespace trdp_sim::trdp
         uint64_t eventLoopErrors{0};
     };
 
-    struct PdSendLogEntry
+    constexpr int kPdSoftDropCode = -32001;
+
+    // One telegram of a PD batch; result receives what sendPdData would have returned.
+    struct PdSendItem
     {
-        uint32_t comId{0};
-        uint32_t channel{0};
-        bool     dropped{false};
+        engine::pd::PdTelegramRuntime* pd{nullptr};
+        const uint8_t*                 data{nullptr};
+        std::size_t                    len{0};
+        int                            result{0};
     };
 
-    constexpr int kPdSoftDropCode = -32001;
-
     class TrdpAdapter
     {
       public:
+        // refCon of PD publications and subscriptions: the session a callback arrived on.
+        struct RxContext
+        {
+            TrdpAdapter* adapter{nullptr};
+            std::size_t  channel{0}; // interface index, see PdEngine::onPdReceived()
+        };
+
         explicit TrdpAdapter(EngineContext& ctx);
 
         bool init();
@@ -50,18 +64,35 @@ namespace trdp_sim::trdp
         // PD
         int publishPd(engine::pd::PdTelegramRuntime& pd);
         int subscribePd(engine::pd::PdTelegramRuntime& pd);
-        int sendPdData(engine::pd::PdTelegramRuntime& pd, const std::vector<uint8_t>& payload);
+        // Transmits straight from the caller's buffer; nothing is copied unless the recorder is on.
+        int sendPdData(engine::pd::PdTelegramRuntime& pd, const uint8_t* data, std::size_t len);
+        int sendPdData(engine::pd::PdTelegramRuntime& pd, const std::vector<uint8_t>& payload)
+        {
+            return sendPdData(pd, payload.data(), payload.size());
+        }
+        // Sends every item with a single redundancy snapshot and diagnostics event. Callers hold
+        // each item's pd.mtx. Returns the number of items sent or soft-dropped.
+        std::size_t sendPdBatch(PdSendItem* items, std::size_t count);
 
         // Callbacks from TRDP stack (will be called by C layer)
-        void handlePdCallback(uint32_t comId, const uint8_t* data, std::size_t len);
+        void handlePdCallback(uint32_t comId, const uint8_t* data, std::size_t len, std::size_t rxChannel = 0);
 
         // MD
         int  sendMdRequest(engine::md::MdSessionRuntime& session, const std::vector<uint8_t>& payload);
         int  sendMdReply(engine::md::MdSessionRuntime& session, const std::vector<uint8_t>& payload);
         void handleMdCallback(const TRDP_MD_INFO_T* info, const uint8_t* data, std::size_t len);
 
-        // Event loop integration
-        void processOnce(); // e.g. called periodically by main loop
+        // Event loop integration: runEventLoop() serves the default session on the calling thread,
+        // sleeping until socket readiness or the next TRDP deadline, until stopEventLoop(). The
+        // sessions of the other interfaces run on I/O threads of their own, started by init().
+        void processOnce(); // one wait-and-process iteration
+        void runEventLoop();
+        void stopEventLoop();
+
+        // One session per configured interface, bound to its host IP. Telegrams without an
+        // interface (or before init()) fall back to EngineContext::trdpSession, the first one.
+        TRDP_APP_SESSION_T sessionFor(const config::BusInterfaceConfig* iface) const;
+        std::size_t        sessionCount() const;
 
         TrdpErrorCounters       getErrorCounters() const;
         std::optional<uint32_t> getLastErrorCode() const;
@@ -75,13 +106,16 @@ namespace trdp_sim::trdp
         bool                                        recoverInterface(const config::BusInterfaceConfig& iface);
         std::vector<trdp_sim::EngineContext::MulticastGroupState> getMulticastState() const;
 
+        // Off by default with the real stack; the stub adapter enables it.
+        PdSendRecorder&       sendRecorder() { return m_sendRecorder; }
+
         // Helpful for tests/stubs
-        std::vector<uint8_t>  getLastPdPayload() const;
+        std::vector<uint8_t>  getLastPdPayload() const; // from the send recorder
         std::vector<uint8_t>  getLastMdRequestPayload() const;
         std::vector<uint8_t>  getLastMdReplyPayload() const;
         std::vector<uint32_t> getRequestedSessions() const;
         std::vector<uint32_t> getRepliedSessions() const;
-        std::vector<PdSendLogEntry> getPdSendLog() const;
+        std::vector<PdSendLogEntry> getPdSendLog() const; // from the send recorder
 
         // Test helpers to simulate network failures
         void setPdSendResult(int rc);
@@ -89,25 +123,46 @@ namespace trdp_sim::trdp
         void setMdReplyResult(int rc);
 
       private:
+        struct InterfaceSession
+        {
+            std::string        name; // BusInterfaceConfig::name, empty without interfaces
+            TRDP_APP_SESSION_T handle{nullptr};
+            RxContext          rx;
+            EventLoop          loop;
+            std::atomic<bool>  stop{false};
+            std::thread        thread; // not used by the default session
+        };
+
         EngineContext&          m_ctx;
         mutable std::mutex      m_errMtx;
         TrdpErrorCounters       m_errorCounters{};
         std::optional<uint32_t> m_lastErrorCode;
-        std::vector<uint8_t>    m_lastPdPayload;
         std::vector<uint8_t>    m_lastMdRequestPayload;
         std::vector<uint8_t>          m_lastMdReplyPayload;
         std::vector<uint32_t>         m_requestedSessions;
         std::vector<uint32_t>         m_repliedSessions;
-        mutable std::vector<PdSendLogEntry> m_pdSendLog;
+        PdSendRecorder                m_sendRecorder;
         std::optional<int>      m_pdSendResult;
         std::optional<int>      m_mdRequestResult;
         std::optional<int>      m_mdReplyResult;
+        EventLoop               m_loop;
+        std::atomic<bool>       m_loopStop{false};
+
+        mutable std::mutex                             m_sessionsMtx;
+        std::vector<std::shared_ptr<InterfaceSession>> m_sessions; // interface order, set by init()
+        std::atomic<uint64_t>                          m_sessionEpoch{1}; // bumped whenever m_sessions changes
 
         mutable std::mutex                                       m_multicastMtx;
         std::unordered_map<std::string, std::unordered_set<std::string>> m_multicastMembership;
 
         void recordError(uint32_t code, uint64_t TrdpErrorCounters::* member);
-        void recordSendLog(uint32_t comId, uint32_t channel, bool dropped) const;
+        std::shared_ptr<InterfaceSession> findSession(const config::BusInterfaceConfig* iface) const;
+        // sessionFor() through a handle cached on the runtime, re-resolved only after init()/deinit().
+        TRDP_APP_SESSION_T cachedSessionFor(const config::BusInterfaceConfig* iface, TRDP_APP_SESSION_T& cached,
+                                            uint64_t& cachedEpoch) const;
+        void processSessionOnce(InterfaceSession& session);
+        int  transmitPd(engine::pd::PdTelegramRuntime& pd, const uint8_t* data, std::size_t len,
+                        const trdp_sim::SimulationControls::RedundancySimulation& redundancy);
     };
 
 } // namespace trdp_sim::trdp
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace trdp_sim::trdp
+{
+
+    /**
+     * epoll-based wait used by the TRDP I/O thread. Sleeps until a watched
+     * socket is readable, the timerfd deadline passes, or wake() is called
+     * from another thread (eventfd), so an idle stack costs no CPU and the
+     * number of descriptors is not bounded by FD_SETSIZE. Not thread-safe
+     * apart from wake().
+     */
+    class EventLoop
+    {
+      public:
+        EventLoop();
+        ~EventLoop();
+        EventLoop(const EventLoop&)            = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+
+        bool valid() const { return m_epollFd >= 0; }
+
+        // Make the watched set equal to `fds`. Only descriptors that joined or left the set
+        // are (un)registered; one dropped by wait() after a hangup or error is re-added.
+        void watch(const std::vector<int>& fds);
+
+        // Block until readiness, timeout or wake(). No timeout waits indefinitely.
+        // Readable watched descriptors are returned in `ready`; -1 on error. A descriptor
+        // reported hung up or in error is returned too and forgotten, since the stack is
+        // about to close it and its number may come back as a different socket.
+        int wait(std::optional<std::chrono::microseconds> timeout, std::vector<int>& ready);
+
+        void wake();
+
+      private:
+        void armTimer(std::optional<std::chrono::microseconds> timeout);
+        void forget(int fd);
+
+        int              m_epollFd{-1};
+        int              m_wakeFd{-1};
+        int              m_timerFd{-1};
+        std::vector<int> m_watched; // sorted
+        std::vector<int> m_scratch; // reused by watch()
+        std::vector<int> m_merged;  // reused by watch()
+        int64_t          m_armedNs{0}; // CLOCK_MONOTONIC deadline the timerfd holds, 0 when disarmed
+    };
+
+} // namespace trdp_sim::trdp
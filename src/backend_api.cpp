@@ -116,6 +116,21 @@ namespace api
             return found && active ? "Active" : "Inactive";
         }
 
+        nlohmann::json percentilesToJson(const diag::LatencyPercentiles& p)
+        {
+            return {{"samples", p.samples}, {"p50Us", p.p50Us},   {"p90Us", p.p90Us},
+                    {"p99Us", p.p99Us},     {"p999Us", p.p999Us}, {"maxUs", p.maxUs}};
+        }
+
+        nlohmann::json histogramToJson(const trdp_sim::util::LatencyHistogram& hist)
+        {
+            const auto snap = hist.snapshot();
+            return {{"samples", snap.samples},
+                    {"p50Us", snap.percentile(0.50)},
+                    {"p99Us", snap.percentile(0.99)},
+                    {"maxUs", snap.maxUs}};
+        }
+
         nlohmann::json ruleToJson(const trdp_sim::SimulationControls::InjectionRule& rule)
         {
             nlohmann::json j;
@@ -165,12 +180,16 @@ namespace api
             item["redundantActive"]  = telPtr->redundantActive;
             item["activeChannel"]    = telPtr->activeChannel;
             item["stats"]["txCount"] = telPtr->stats.txCount;
+            item["stats"]["txErrors"] = telPtr->stats.txErrors;
             item["stats"]["rxCount"] = telPtr->stats.rxCount;
             item["stats"]["timeoutCount"]      = telPtr->stats.timeoutCount;
             item["stats"]["lastSeqNumber"]     = telPtr->stats.lastSeqNumber;
             item["stats"]["lastTxTime"]        = telPtr->stats.lastTxTime.time_since_epoch().count();
             item["stats"]["lastRxTime"]        = telPtr->stats.lastRxTime.time_since_epoch().count();
             item["stats"]["lastCycleJitterUs"] = telPtr->stats.lastCycleJitterUs;
+            item["stats"]["cycleJitter"]       = histogramToJson(telPtr->jitterHist);
+            item["stats"]["decodes"]           = telPtr->stats.decodes;
+            item["stats"]["coalescedFrames"]   = telPtr->stats.coalescedFrames;
             arr.push_back(std::move(item));
         }
         return arr;
@@ -184,7 +203,8 @@ namespace api
     nlohmann::json BackendApi::getDataSetValues(uint32_t dataSetId) const
     {
         nlohmann::json j;
-        auto           it = m_ctx.dataSetInstances.find(dataSetId);
+        m_pd.syncDataSet(dataSetId);
+        auto it = m_ctx.dataSetInstances.find(dataSetId);
         if (it == m_ctx.dataSetInstances.end())
             return j;
 
@@ -217,19 +237,19 @@ namespace api
 
         if (inst->def)
         {
-            for (std::size_t idx = 0; idx < inst->def->elements.size() && idx < inst->values.size(); ++idx)
+            for (std::size_t idx = 0; idx < inst->def->elements.size() && idx < data::elementCount(*inst); ++idx)
             {
                 nlohmann::json cell;
                 const auto&    def = inst->def->elements[idx];
-                const auto&    val = inst->values[idx];
+                const auto     raw = data::elementBytes(*inst, idx);
                 cell["name"]       = def.name;
                 cell["type"]       = elementTypeToString(def.type);
                 cell["arraySize"]  = def.arraySize;
                 if (def.nestedDataSetId)
                     cell["nestedDataSetId"] = *def.nestedDataSetId;
-                cell["defined"] = val.defined;
-                cell["raw"]     = val.raw;
-                cell["rawHex"]  = bytesToHex(val.raw);
+                cell["defined"] = data::isElementDefined(*inst, idx);
+                cell["raw"]     = raw;
+                cell["rawHex"]  = bytesToHex(raw);
                 j["values"].push_back(std::move(cell));
             }
         }
@@ -257,7 +277,7 @@ namespace api
             return false;
         }
         std::lock_guard<std::mutex> lock(inst->mtx);
-        if (elementIdx >= inst->values.size())
+        if (elementIdx >= data::elementCount(*inst))
         {
             if (error)
                 *error = "Invalid element index";
@@ -299,8 +319,7 @@ namespace api
             return false;
         }
 
-        inst->values[elementIdx].raw     = value;
-        inst->values[elementIdx].defined = true;
+        data::setElementBytes(*inst, elementIdx, value.data(), value.size());
         return true;
     }
 
@@ -314,7 +333,7 @@ namespace api
             return false;
         }
         std::lock_guard<std::mutex> lock(inst->mtx);
-        if (elementIdx >= inst->values.size())
+        if (elementIdx >= data::elementCount(*inst))
         {
             if (error)
                 *error = "Invalid element index";
@@ -333,8 +352,7 @@ namespace api
             return false;
         }
 
-        inst->values[elementIdx].raw.clear();
-        inst->values[elementIdx].defined = false;
+        data::clearElement(*inst, elementIdx);
         return true;
     }
 
@@ -360,11 +378,9 @@ namespace api
                 *error = "Dataset is locked";
             return false;
         }
-        for (auto& cell : inst->values)
-        {
-            cell.raw.clear();
-            cell.defined = false;
-        }
+        data::DataSetWriteBatch batch(*inst); // one published snapshot for the whole clear
+        for (std::size_t idx = 0; idx < data::elementCount(*inst); ++idx)
+            data::clearElement(*inst, idx);
         return true;
     }
 
@@ -379,6 +395,7 @@ namespace api
         }
         std::lock_guard<std::mutex> guard(inst->mtx);
         inst->locked = lock;
+        data::markModified(*inst);
         return true;
     }
 
@@ -413,9 +430,11 @@ namespace api
         j["stats"]["rxCount"]      = sess->stats.rxCount;
         j["stats"]["retryCount"]   = sess->stats.retryCount;
         j["stats"]["timeoutCount"] = sess->stats.timeoutCount;
+        j["stats"]["pacedDispatches"] = sess->stats.pacedDispatches;
         j["stats"]["lastTxTime"]   = sess->stats.lastTxTime.time_since_epoch().count();
         j["stats"]["lastRxTime"]   = sess->stats.lastRxTime.time_since_epoch().count();
         j["stats"]["lastRoundTripUs"] = sess->stats.lastRoundTripUs;
+        j["stats"]["roundTrip"]       = histogramToJson(sess->roundTripHist);
 
         auto bytesToHex = [](const std::vector<uint8_t>& data)
         {
@@ -439,19 +458,19 @@ namespace api
             json["values"]     = nlohmann::json::array();
             if (inst->def)
             {
-                for (std::size_t idx = 0; idx < inst->def->elements.size() && idx < inst->values.size(); ++idx)
+                for (std::size_t idx = 0; idx < inst->def->elements.size() && idx < data::elementCount(*inst); ++idx)
                 {
                     nlohmann::json cell;
                     const auto&    def = inst->def->elements[idx];
-                    const auto&    val = inst->values[idx];
+                    const auto     raw = data::elementBytes(*inst, idx);
                     cell["name"]       = def.name;
                     cell["type"]       = def.type;
                     cell["arraySize"]  = def.arraySize;
                     if (def.nestedDataSetId)
                         cell["nestedDataSetId"] = *def.nestedDataSetId;
-                    cell["defined"] = val.defined;
-                    cell["raw"]     = val.raw;
-                    cell["rawHex"]  = bytesToHex(val.raw);
+                    cell["defined"] = data::isElementDefined(*inst, idx);
+                    cell["raw"]     = raw;
+                    cell["rawHex"]  = bytesToHex(raw);
                     json["values"].push_back(std::move(cell));
                 }
             }
@@ -851,6 +870,48 @@ namespace api
         j["pd"]["stressBursts"]     = m.pd.stressBursts;
         j["pd"]["redundancySwitches"] = m.pd.redundancySwitches;
         j["pd"]["busFailureDrops"]    = m.pd.busFailureDrops;
+        j["pd"]["missedCycles"]       = m.pd.missedCycles;
+        j["pd"]["maxLatenessUs"]      = m.pd.maxLatenessUs;
+        j["pd"]["cycleJitter"]        = percentilesToJson(m.pd.cycleJitter);
+        j["pd"]["payloadCacheHits"]   = m.pd.payloadCacheHits;
+        j["pd"]["coalescedFrames"]    = m.pd.coalescedFrames;
+        j["pd"]["payloadCacheMisses"] = m.pd.payloadCacheMisses;
+        const auto payloadLookups     = m.pd.payloadCacheHits + m.pd.payloadCacheMisses;
+        j["pd"]["payloadCacheHitRate"] =
+            payloadLookups ? static_cast<double>(m.pd.payloadCacheHits) / static_cast<double>(payloadLookups) : 0.0;
+        j["pd"]["stressTargetRate"]    = m.pd.stressTargetRate;
+        j["pd"]["stressAchievedRate"]  = m.pd.stressAchievedRate;
+        j["pd"]["realtimeThread"]      = m.pd.realtimeThread;
+        j["pd"]["wakeupLatencyMeanUs"] = m.pd.wakeupLatencyMeanUs;
+        j["pd"]["wakeupLatencyMaxUs"]  = m.pd.wakeupLatencyMaxUs;
+        j["pd"]["shards"]              = nlohmann::json::array();
+        for (const auto& shard : m.pd.shards)
+        {
+            nlohmann::json sj;
+            sj["index"]              = shard.index;
+            sj["publishers"]         = shard.publishers;
+            sj["sends"]              = shard.sends;
+            sj["sendErrors"]         = shard.sendErrors;
+            sj["maxPassUs"]          = shard.maxPassUs;
+            sj["maxSendsPerPass"]    = shard.maxSendsPerPass;
+            sj["meanSendsPerPass"] =
+                shard.passes ? static_cast<double>(shard.sends) / static_cast<double>(shard.passes) : 0.0;
+            sj["wakeupLatencyMaxUs"] = shard.wakeupLatencyMaxUs;
+            j["pd"]["shards"].push_back(sj);
+        }
+        j["pd"]["rxRings"] = nlohmann::json::array();
+        for (const auto& ring : m.pd.rxRings)
+        {
+            nlohmann::json rj;
+            rj["channel"]   = ring.channel;
+            rj["interface"] = ring.interfaceName;
+            rj["capacity"]  = ring.capacity;
+            rj["occupancy"] = ring.occupancy;
+            rj["highWater"] = ring.highWater;
+            rj["enqueued"]  = ring.enqueued;
+            rj["overflows"] = ring.overflows;
+            j["pd"]["rxRings"].push_back(rj);
+        }
 
         j["md"]["sessions"]     = m.md.sessions;
         j["md"]["txCount"]      = m.md.txCount;
@@ -858,6 +919,7 @@ namespace api
         j["md"]["retryCount"]   = m.md.retryCount;
         j["md"]["timeoutCount"] = m.md.timeoutCount;
         j["md"]["maxLatencyUs"] = m.md.maxLatencyUs;
+        j["md"]["roundTrip"]    = percentilesToJson(m.md.roundTrip);
 
         j["trdp"]["initErrors"]      = m.trdp.initErrors;
         j["trdp"]["publishErrors"]   = m.trdp.publishErrors;
@@ -994,18 +1056,34 @@ namespace api
     nlohmann::json BackendApi::getSimulationState() const
     {
         nlohmann::json j;
+        const auto                  rateStats = m_pd.rateStats();
         std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
-        for (const auto& [comId, rule] : m_ctx.simulation.pdRules)
+        const auto                  rules = m_ctx.simulation.injectionRules();
+        for (const auto& [comId, rule] : rules->pdRules)
             j["pdRules"].push_back({{"comId", comId}, {"rule", ruleToJson(rule)}});
-        for (const auto& [comId, rule] : m_ctx.simulation.mdRules)
+        for (const auto& [comId, rule] : rules->mdRules)
             j["mdRules"].push_back({{"comId", comId}, {"rule", ruleToJson(rule)}});
-        for (const auto& [dsId, rule] : m_ctx.simulation.dataSetRules)
+        for (const auto& [dsId, rule] : rules->dataSetRules)
             j["dataSetRules"].push_back({{"dataSetId", dsId}, {"rule", ruleToJson(rule)}});
+        j["rulesVersion"] = rules->version;
         j["stress"]["enabled"]          = m_ctx.simulation.stress.enabled;
         j["stress"]["pdCycleOverrideUs"] = m_ctx.simulation.stress.pdCycleOverrideUs;
         j["stress"]["pdBurstTelegrams"] = m_ctx.simulation.stress.pdBurstTelegrams;
         j["stress"]["mdBurst"]          = m_ctx.simulation.stress.mdBurst;
         j["stress"]["mdIntervalUs"]     = m_ctx.simulation.stress.mdIntervalUs;
+        if (const auto& rates = m_ctx.simulation.stress.pdRates)
+        {
+            for (const auto& [comId, rate] : rates->perComId)
+                j["stress"]["pdRates"]["comIds"][std::to_string(comId)] = rate;
+            for (const auto& [name, rate] : rates->perInterface)
+                j["stress"]["pdRates"]["interfaces"][name] = rate;
+        }
+        j["stress"]["pdRateStats"] = nlohmann::json::array();
+        for (const auto& rate : rateStats)
+            j["stress"]["pdRateStats"].push_back({{"comId", rate.comId},
+                                                  {"interface", rate.interfaceName},
+                                                  {"targetPerSecond", rate.targetPerSecond},
+                                                  {"achievedPerSecond", rate.achievedPerSecond}});
         j["redundancy"]["forceSwitch"]  = m_ctx.simulation.redundancy.forceSwitch;
         j["redundancy"]["busFailure"]    = m_ctx.simulation.redundancy.busFailure;
         j["redundancy"]["failedChannel"] = m_ctx.simulation.redundancy.failedChannel;
@@ -1026,32 +1104,35 @@ namespace api
     void BackendApi::upsertPdInjectionRule(uint32_t comId, const trdp_sim::SimulationControls::InjectionRule& rule)
     {
         std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
-        m_ctx.simulation.pdRules[comId] = rule;
+        auto                        next = *m_ctx.simulation.injectionRules();
+        next.pdRules[comId]         = rule;
+        m_ctx.simulation.publishInjectionRules(std::move(next));
     }
 
     void BackendApi::upsertMdInjectionRule(uint32_t comId, const trdp_sim::SimulationControls::InjectionRule& rule)
     {
         std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
-        m_ctx.simulation.mdRules[comId] = rule;
+        auto                        next = *m_ctx.simulation.injectionRules();
+        next.mdRules[comId]         = rule;
+        m_ctx.simulation.publishInjectionRules(std::move(next));
     }
 
     void BackendApi::upsertDataSetInjectionRule(uint32_t dataSetId, const trdp_sim::SimulationControls::InjectionRule& rule)
     {
         std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
-        m_ctx.simulation.dataSetRules[dataSetId] = rule;
+        auto                        next = *m_ctx.simulation.injectionRules();
+        next.dataSetRules[dataSetId] = rule;
+        m_ctx.simulation.publishInjectionRules(std::move(next));
     }
 
     void BackendApi::clearInjectionRules()
     {
         std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
-        m_ctx.simulation.pdRules.clear();
-        m_ctx.simulation.mdRules.clear();
-        m_ctx.simulation.dataSetRules.clear();
+        m_ctx.simulation.publishInjectionRules({});
     }
 
     void BackendApi::setStressMode(const trdp_sim::SimulationControls::StressMode& stress)
     {
-        std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
         auto sanitized                   = stress;
         sanitized.pdBurstTelegrams       =
             std::min<std::size_t>(stress.pdBurstTelegrams,
@@ -1063,7 +1144,25 @@ namespace api
             sanitized.pdCycleOverrideUs = trdp_sim::SimulationControls::StressMode::kMinCycleUs;
         if (sanitized.mdIntervalUs > 0 && sanitized.mdIntervalUs < trdp_sim::SimulationControls::StressMode::kMinCycleUs)
             sanitized.mdIntervalUs = trdp_sim::SimulationControls::StressMode::kMinCycleUs;
-        m_ctx.simulation.stress = sanitized;
+        if (stress.pdRates)
+        {
+            // Drop non-positive targets and cap the rest so one bad entry cannot flood the bus.
+            auto       rates = std::make_shared<trdp_sim::SimulationControls::PdRateTargets>();
+            const auto clampRate = [](double r)
+            { return std::min(r, trdp_sim::SimulationControls::StressMode::kMaxRatePerSecond); };
+            for (const auto& [comId, rate] : stress.pdRates->perComId)
+                if (rate > 0.0)
+                    rates->perComId[comId] = clampRate(rate);
+            for (const auto& [name, rate] : stress.pdRates->perInterface)
+                if (rate > 0.0)
+                    rates->perInterface[name] = clampRate(rate);
+            sanitized.pdRates = std::move(rates);
+        }
+        {
+            std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
+            m_ctx.simulation.stress = sanitized;
+        }
+        m_pd.reschedule();
     }
 
     void BackendApi::setRedundancySimulation(const trdp_sim::SimulationControls::RedundancySimulation& sim)
@@ -1,9 +1,11 @@
 #include "backend_engine.hpp"
 
+#include "data_marshalling.hpp"
 #include "diagnostic_manager.hpp"
 #include "trdp_adapter.hpp"
 
 #include <mutex>
+#include <unordered_set>
 
 namespace trdp_sim
 {
@@ -29,8 +31,26 @@ namespace trdp_sim
             newInsts[def.id] = std::move(inst);
         }
 
+        // Telegrams with marshall="false" keep the whole frame in element 0, which only the
+        // per-cell layout can hold.
+        std::unordered_set<uint32_t> rawDataSets;
+        for (const auto& iface : cfg.interfaces)
+        {
+            for (const auto& tel : iface.telegrams)
+            {
+                if (tel.pdParam && !tel.pdParam->marshall)
+                    rawDataSets.insert(tel.dataSetId);
+            }
+        }
+
         m_ctx.dataSetDefs      = std::move(newDefs);
         m_ctx.dataSetInstances = std::move(newInsts);
+        util::compileMarshalPlans(m_ctx);
+        for (auto& [id, inst] : m_ctx.dataSetInstances)
+        {
+            if (!rawDataSets.count(id))
+                data::enableContiguousStorage(*inst);
+        }
     }
 
     namespace
@@ -53,6 +73,7 @@ namespace trdp_sim
         if (!activateTransport && m_ctx.trdpAdapter)
             m_ctx.trdpAdapter->deinit();
 
+        m_ctx.pdSubscribersByComId.clear();
         m_ctx.pdTelegrams.clear();
         m_ctx.mdSessions.clear();
 
@@ -1,5 +1,8 @@
 #include "data_marshalling.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace trdp_sim::util
 {
 
@@ -35,8 +38,123 @@ namespace trdp_sim::util
             }
             return 0;
         }
+
+        constexpr int kMaxNestingDepth = 16;
+
+        // Add the wire size of `def` to `size`; returns false on unresolved or too deep nesting.
+        bool addResolvedSize(const data::DataSetDef& def, const EngineContext& ctx, std::size_t& size, int depth)
+        {
+            if (depth > kMaxNestingDepth)
+                return false;
+            for (const auto& el : def.elements)
+            {
+                if (el.type != data::ElementType::NESTED_DATASET)
+                {
+                    size += elementTypeSize(el.type) * el.arraySize;
+                    continue;
+                }
+                if (!el.nestedDataSetId)
+                    continue;
+                auto it = ctx.dataSetDefs.find(*el.nestedDataSetId);
+                if (it == ctx.dataSetDefs.end())
+                    return false;
+                for (uint32_t i = 0; i < el.arraySize; ++i)
+                {
+                    if (!addResolvedSize(it->second, ctx, size, depth + 1))
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        void marshalWithPlan(const data::MarshalPlan& plan, const data::DataSetInstance& inst, std::vector<uint8_t>& out)
+        {
+            const auto count = std::min(plan.slots.size(), inst.values.size());
+            out.assign(count < plan.slots.size() ? plan.slots[count].offset : plan.totalSize, 0);
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                const auto& slot = plan.slots[idx];
+                const auto& cell = inst.values[idx];
+                if (!cell.defined || cell.raw.empty())
+                    continue;
+                std::memcpy(out.data() + slot.offset, cell.raw.data(), std::min(cell.raw.size(), slot.size));
+            }
+        }
+
+        void unmarshalContiguous(data::DataSetInstance& inst, const uint8_t* data, std::size_t len)
+        {
+            const auto& plan   = *inst.plan;
+            const auto  toCopy = data ? std::min(len, inst.buffer.size()) : 0;
+            if (toCopy > 0)
+                std::memcpy(inst.buffer.data(), data, toCopy);
+            std::fill(inst.buffer.begin() + static_cast<std::ptrdiff_t>(toCopy), inst.buffer.end(), 0);
+            std::fill(inst.definedBits.begin(), inst.definedBits.end(), 0);
+            for (std::size_t idx = 0; idx < plan.slots.size(); ++idx)
+            {
+                const auto& slot = plan.slots[idx];
+                if (slot.size > 0 && slot.offset < toCopy)
+                    inst.definedBits[idx / 64] |= uint64_t{1} << (idx % 64);
+            }
+            data::markModified(inst);
+        }
+
+        void unmarshalWithPlan(const data::MarshalPlan& plan, data::DataSetInstance& inst, const uint8_t* data,
+                               std::size_t len)
+        {
+            const auto count = std::min(plan.slots.size(), inst.values.size());
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                const auto& slot = plan.slots[idx];
+                auto&       cell = inst.values[idx];
+                if (slot.size == 0)
+                    continue;
+                if (!data || slot.offset >= len)
+                {
+                    cell.raw.assign(slot.size, 0);
+                    cell.defined = false;
+                    continue;
+                }
+                const auto toCopy = std::min(slot.size, len - slot.offset);
+                cell.raw.resize(slot.size);
+                std::memcpy(cell.raw.data(), data + slot.offset, toCopy);
+                if (toCopy < slot.size)
+                    std::fill(cell.raw.begin() + static_cast<std::ptrdiff_t>(toCopy), cell.raw.end(), 0);
+                cell.defined = true;
+            }
+        }
     } // namespace
 
+    std::shared_ptr<const data::MarshalPlan> compileMarshalPlan(const data::DataSetDef& def, const EngineContext& ctx)
+    {
+        auto        plan   = std::make_shared<data::MarshalPlan>();
+        std::size_t offset = 0;
+        for (const auto& el : def.elements)
+        {
+            const auto start = offset;
+            if (el.type == data::ElementType::NESTED_DATASET && !el.nestedDataSetId)
+            {
+                plan->slots.push_back({start, 0, el.type, el.arraySize});
+                continue;
+            }
+            data::DataSetDef single;
+            single.elements.push_back(el);
+            if (!addResolvedSize(single, ctx, offset, 0))
+                return nullptr;
+            plan->slots.push_back({start, offset - start, el.type, el.arraySize});
+        }
+        plan->totalSize = offset;
+        return plan;
+    }
+
+    void compileMarshalPlans(EngineContext& ctx)
+    {
+        for (auto& [id, inst] : ctx.dataSetInstances)
+        {
+            if (inst && inst->def)
+                inst->plan = compileMarshalPlan(*inst->def, ctx);
+        }
+    }
+
     std::size_t elementSize(const data::ElementDef& def, const EngineContext& ctx)
     {
         if (def.type == data::ElementType::NESTED_DATASET)
@@ -60,6 +178,14 @@ namespace trdp_sim::util
         if (!inst.def)
             return out;
 
+        if (inst.contiguous)
+            return inst.buffer; // undefined elements are kept zeroed
+        if (inst.plan)
+        {
+            marshalWithPlan(*inst.plan, inst, out);
+            return out;
+        }
+
         for (std::size_t idx = 0; idx < inst.def->elements.size() && idx < inst.values.size(); ++idx)
         {
             const auto& el           = inst.def->elements[idx];
@@ -91,6 +217,18 @@ namespace trdp_sim::util
         if (!inst.def)
             return;
 
+        if (inst.contiguous)
+        {
+            unmarshalContiguous(inst, len == 0 ? nullptr : data, len);
+            return;
+        }
+        if (inst.plan)
+        {
+            unmarshalWithPlan(*inst.plan, inst, len == 0 ? nullptr : data, len);
+            data::markModified(inst);
+            return;
+        }
+
         if (!data || len == 0)
         {
             for (std::size_t idx = 0; idx < inst.def->elements.size() && idx < inst.values.size(); ++idx)
@@ -99,6 +237,7 @@ namespace trdp_sim::util
                 cell.raw.assign(elementSize(inst.def->elements[idx], ctx), 0);
                 cell.defined = false;
             }
+            data::markModified(inst);
             return;
         }
 
@@ -126,6 +265,7 @@ namespace trdp_sim::util
             cell.defined = true;
             offset += expectedSize;
         }
+        data::markModified(inst);
     }
 
 } // namespace trdp_sim::util
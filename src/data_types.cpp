@@ -1,6 +1,173 @@
 #include "data_types.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
 namespace data
 {
-    // Currently no standalone implementation; kept for future helpers.
-}
+
+    namespace
+    {
+        // Copy the back buffer into a snapshot and make it the published one. The retired
+        // snapshot is kept as the spare and refilled once no reader still holds it.
+        void publish(DataSetInstance& inst)
+        {
+            inst.publishPending = false;
+            auto snap           = std::move(inst.spare);
+            if (!snap || snap.use_count() != 1)
+                snap = std::make_shared<DataSetSnapshot>();
+            std::atomic_thread_fence(std::memory_order_acquire); // after the last reader let go
+            snap->generation = inst.generation;
+            snap->bytes.assign(inst.buffer.begin(), inst.buffer.end());
+            snap->definedBits.assign(inst.definedBits.begin(), inst.definedBits.end());
+            std::atomic_store_explicit(&inst.published, std::shared_ptr<const DataSetSnapshot>(snap),
+                                       std::memory_order_release);
+            inst.spare = std::move(inst.front);
+            inst.front = std::move(snap);
+        }
+
+        void setBit(DataSetInstance& inst, std::size_t idx, bool on)
+        {
+            auto&         word = inst.definedBits[idx / 64];
+            const uint64_t mask = uint64_t{1} << (idx % 64);
+            word                = on ? (word | mask) : (word & ~mask);
+        }
+    } // namespace
+
+    std::size_t elementCount(const DataSetInstance& inst)
+    {
+        return inst.contiguous ? inst.plan->slots.size() : inst.values.size();
+    }
+
+    bool isElementDefined(const DataSetInstance& inst, std::size_t idx)
+    {
+        if (idx >= elementCount(inst))
+            return false;
+        if (!inst.contiguous)
+            return inst.values[idx].defined;
+        return (inst.definedBits[idx / 64] >> (idx % 64)) & 1u;
+    }
+
+    std::vector<uint8_t> elementBytes(const DataSetInstance& inst, std::size_t idx)
+    {
+        if (idx >= elementCount(inst))
+            return {};
+        if (!inst.contiguous)
+            return inst.values[idx].raw;
+        // Undefined slots are kept zeroed, so they read back zero-filled at full size.
+        const auto& slot  = inst.plan->slots[idx];
+        const auto  begin = inst.buffer.begin() + static_cast<std::ptrdiff_t>(slot.offset);
+        return std::vector<uint8_t>(begin, begin + static_cast<std::ptrdiff_t>(slot.size));
+    }
+
+    void setElementBytes(DataSetInstance& inst, std::size_t idx, const uint8_t* bytes, std::size_t len)
+    {
+        if (idx >= elementCount(inst))
+            return;
+        if (!inst.contiguous)
+        {
+            auto& cell = inst.values[idx];
+            cell.raw.assign(bytes, bytes + len);
+            cell.defined = true;
+            markModified(inst);
+            return;
+        }
+        const auto& slot   = inst.plan->slots[idx];
+        auto*       dst    = inst.buffer.data() + slot.offset;
+        const auto  toCopy = std::min(len, slot.size);
+        if (toCopy > 0)
+            std::memcpy(dst, bytes, toCopy);
+        std::fill(dst + toCopy, dst + slot.size, 0);
+        setBit(inst, idx, true);
+        markModified(inst);
+    }
+
+    void clearElement(DataSetInstance& inst, std::size_t idx)
+    {
+        if (idx >= elementCount(inst))
+            return;
+        if (!inst.contiguous)
+        {
+            inst.values[idx].raw.clear();
+            inst.values[idx].defined = false;
+            markModified(inst);
+            return;
+        }
+        const auto& slot = inst.plan->slots[idx];
+        std::fill(inst.buffer.begin() + static_cast<std::ptrdiff_t>(slot.offset),
+                  inst.buffer.begin() + static_cast<std::ptrdiff_t>(slot.offset + slot.size), 0);
+        setBit(inst, idx, false);
+        markModified(inst);
+    }
+
+    void zeroAllElements(DataSetInstance& inst)
+    {
+        if (!inst.contiguous)
+        {
+            for (auto& cell : inst.values)
+            {
+                cell.defined = false;
+                std::fill(cell.raw.begin(), cell.raw.end(), 0);
+            }
+            markModified(inst);
+            return;
+        }
+        std::fill(inst.buffer.begin(), inst.buffer.end(), 0);
+        std::fill(inst.definedBits.begin(), inst.definedBits.end(), 0);
+        markModified(inst);
+    }
+
+    bool enableContiguousStorage(DataSetInstance& inst)
+    {
+        if (inst.contiguous)
+            return true;
+        if (!inst.plan)
+            return false;
+
+        const auto&            plan = *inst.plan;
+        std::vector<ValueCell> cells;
+        cells.swap(inst.values);
+        inst.buffer.assign(plan.totalSize, 0);
+        inst.definedBits.assign((plan.slots.size() + 63) / 64, 0);
+        inst.contiguous = true;
+        DataSetWriteBatch batch(inst);
+        for (std::size_t idx = 0; idx < cells.size() && idx < plan.slots.size(); ++idx)
+        {
+            if (cells[idx].defined)
+                setElementBytes(inst, idx, cells[idx].raw.data(), cells[idx].raw.size());
+        }
+        markModified(inst);
+        return true;
+    }
+
+    std::shared_ptr<const DataSetSnapshot> publishedSnapshot(const DataSetInstance& inst)
+    {
+        return std::atomic_load_explicit(&inst.published, std::memory_order_acquire);
+    }
+
+    void markModified(DataSetInstance& inst)
+    {
+        ++inst.generation;
+        if (!inst.contiguous)
+            return;
+        if (inst.publishDeferred > 0)
+        {
+            inst.publishPending = true;
+            return;
+        }
+        publish(inst);
+    }
+
+    DataSetWriteBatch::DataSetWriteBatch(DataSetInstance& inst) : m_inst(inst)
+    {
+        ++m_inst.publishDeferred;
+    }
+
+    DataSetWriteBatch::~DataSetWriteBatch()
+    {
+        if (--m_inst.publishDeferred == 0 && m_inst.publishPending)
+            publish(m_inst);
+    }
+
+} // namespace data
@@ -20,12 +20,25 @@ namespace diag
 
         constexpr std::size_t kPcapGlobalHeaderSize = sizeof(uint32_t) * 6;
 
+        LatencyPercentiles toPercentiles(const trdp_sim::util::LatencyHistogram::Snapshot& hist)
+        {
+            LatencyPercentiles out;
+            out.samples = hist.samples;
+            out.p50Us   = hist.percentile(0.50);
+            out.p90Us   = hist.percentile(0.90);
+            out.p99Us   = hist.percentile(0.99);
+            out.p999Us  = hist.percentile(0.999);
+            out.maxUs   = static_cast<double>(hist.maxUs);
+            return out;
+        }
+
     } // namespace
 
     DiagnosticManager::DiagnosticManager(trdp_sim::EngineContext& ctx, engine::pd::PdEngine& pd,
                                          engine::md::MdEngine& md, trdp_sim::trdp::TrdpAdapter& adapter,
                                          const LogConfig& cfg, const PcapConfig& pcapCfg)
-        : m_ctx(ctx), m_pd(pd), m_md(md), m_adapter(adapter), m_logCfg(cfg), m_pcapCfg(pcapCfg)
+        : m_ctx(ctx), m_pd(pd), m_md(md), m_adapter(adapter), m_logCfg(cfg),
+          m_minSeverity(static_cast<int>(cfg.minimumSeverity)), m_pcapCfg(pcapCfg)
     {
         if (m_logCfg.filePath)
             m_logPath = *m_logCfg.filePath;
@@ -117,6 +130,7 @@ namespace diag
     {
         std::lock_guard<std::mutex> lk(m_logCfgMtx);
         m_logCfg = cfg;
+        m_minSeverity.store(static_cast<int>(cfg.minimumSeverity), std::memory_order_relaxed);
         if (m_logCfg.filePath)
             m_logPath = *m_logCfg.filePath;
     }
@@ -405,10 +419,12 @@ namespace diag
         snapshot.threads.mdThreadRunning   = m_md.isRunning();
         snapshot.threads.trdpThreadRunning = m_ctx.running;
 
+        trdp_sim::util::LatencyHistogram::Snapshot pdJitter;
         for (const auto& pdPtr : m_ctx.pdTelegrams)
         {
             if (!pdPtr)
                 continue;
+            pdJitter.merge(pdPtr->jitterHist.snapshot());
             std::lock_guard<std::mutex> lk(pdPtr->mtx);
             snapshot.pd.telegrams++;
             snapshot.pd.txCount += pdPtr->stats.txCount;
@@ -417,6 +433,11 @@ namespace diag
             snapshot.pd.stressBursts += pdPtr->stats.stressBursts;
             snapshot.pd.redundancySwitches += pdPtr->stats.redundancySwitches;
             snapshot.pd.busFailureDrops += pdPtr->stats.busFailureDrops;
+            snapshot.pd.missedCycles += pdPtr->stats.missedCycles;
+            snapshot.pd.maxLatenessUs = std::max(snapshot.pd.maxLatenessUs, pdPtr->stats.maxLatenessUs);
+            snapshot.pd.payloadCacheHits += pdPtr->stats.payloadCacheHits;
+            snapshot.pd.payloadCacheMisses += pdPtr->stats.payloadCacheMisses;
+            snapshot.pd.coalescedFrames += pdPtr->stats.coalescedFrames;
             snapshot.pd.maxCycleJitterUs = std::max(snapshot.pd.maxCycleJitterUs, pdPtr->stats.lastCycleJitterUs);
             snapshot.pd.maxInterarrivalUs =
                 std::max(snapshot.pd.maxInterarrivalUs, pdPtr->stats.lastInterarrivalUs);
@@ -430,9 +451,49 @@ namespace diag
                 snapshot.pd.latestTxWall = pdPtr->stats.lastTxWall;
         }
 
+        snapshot.pd.cycleJitter = toPercentiles(pdJitter);
+
+        for (const auto& rate : m_pd.rateStats())
+        {
+            snapshot.pd.stressTargetRate += rate.targetPerSecond;
+            snapshot.pd.stressAchievedRate += rate.achievedPerSecond;
+        }
+
+        const auto wakeup                = m_pd.wakeupStats();
+        snapshot.pd.realtimeThread       = wakeup.realtime;
+        snapshot.pd.wakeupLatencyMeanUs  = wakeup.meanUs;
+        snapshot.pd.wakeupLatencyMaxUs   = wakeup.maxUs;
+        for (const auto& shard : m_pd.shardStats())
+        {
+            PdShardMetrics sm{};
+            sm.index              = shard.index;
+            sm.publishers         = shard.publishers;
+            sm.sends              = shard.sends;
+            sm.sendErrors         = shard.sendErrors;
+            sm.passes             = shard.passes;
+            sm.maxPassUs          = shard.maxPassUs;
+            sm.maxSendsPerPass    = shard.maxSendsPerPass;
+            sm.wakeupLatencyMaxUs = shard.wakeup.maxUs;
+            snapshot.pd.shards.push_back(sm);
+        }
+        for (const auto& rx : m_pd.rxStats())
+        {
+            PdRxRingMetrics rm{};
+            rm.channel       = rx.channel;
+            rm.interfaceName = rx.interfaceName;
+            rm.capacity      = rx.ring.capacity;
+            rm.occupancy     = rx.ring.occupancy;
+            rm.highWater     = rx.ring.highWater;
+            rm.enqueued      = rx.ring.pushed;
+            rm.overflows     = rx.ring.overflows;
+            snapshot.pd.rxRings.push_back(rm);
+        }
+
+        trdp_sim::util::LatencyHistogram::Snapshot mdRoundTrip;
         m_md.forEachSession(
-            [&snapshot](const engine::md::MdSessionRuntime& sess)
+            [&snapshot, &mdRoundTrip](const engine::md::MdSessionRuntime& sess)
             {
+                mdRoundTrip.merge(sess.roundTripHist.snapshot());
                 snapshot.md.sessions++;
                 snapshot.md.txCount += sess.stats.txCount;
                 snapshot.md.rxCount += sess.stats.rxCount;
@@ -451,6 +512,7 @@ namespace diag
                     snapshot.md.maxLatencyUs = std::max(snapshot.md.maxLatencyUs, static_cast<double>(latency.count()));
                 }
             });
+        snapshot.md.roundTrip = toPercentiles(mdRoundTrip);
 
         auto trdpErrors               = m_adapter.getErrorCounters();
         snapshot.trdp.initErrors      = trdpErrors.initErrors;
@@ -473,7 +535,9 @@ namespace diag
             << ") pd(tx=" << snapshot.pd.txCount << ", rx=" << snapshot.pd.rxCount
             << ", timeout=" << snapshot.pd.timeoutCount << ", active_to=" << snapshot.pd.activeTimeouts
             << ", bursts=" << snapshot.pd.stressBursts << ", switches=" << snapshot.pd.redundancySwitches
-            << ", bus_drop=" << snapshot.pd.busFailureDrops << ", jitter(us)=" << snapshot.pd.maxCycleJitterUs
+            << ", bus_drop=" << snapshot.pd.busFailureDrops << ", missed=" << snapshot.pd.missedCycles
+            << ", late(us)=" << snapshot.pd.maxLatenessUs << ", wake(us)=" << snapshot.pd.wakeupLatencyMaxUs
+            << ", jitter(us)=" << snapshot.pd.maxCycleJitterUs
             << ", inter(us)=" << snapshot.pd.maxInterarrivalUs << ") md(tx=" << snapshot.md.txCount
             << ", rx=" << snapshot.md.rxCount
             << ", timeout=" << snapshot.md.timeoutCount << ", retry=" << snapshot.md.retryCount
@@ -483,8 +547,7 @@ namespace diag
 
     bool DiagnosticManager::shouldLog(Severity sev) const
     {
-        std::lock_guard<std::mutex> lk(m_logCfgMtx);
-        return static_cast<int>(sev) >= static_cast<int>(m_logCfg.minimumSeverity);
+        return static_cast<int>(sev) >= m_minSeverity.load(std::memory_order_relaxed);
     }
 
     std::string DiagnosticManager::severityToString(Severity sev) const
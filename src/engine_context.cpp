@@ -8,9 +8,23 @@
 namespace trdp_sim
 {
 
-    // Currently EngineContext is a plain struct with no behavior.
-    // This file is kept for future helper functions or initialization
-    // utilities that operate on EngineContext.
+    // EngineContext is mostly plain data; this file holds the few helpers
+    // that operate on it.
+
+    std::shared_ptr<const SimulationControls::InjectionRuleSet> SimulationControls::injectionRules() const
+    {
+        return std::atomic_load_explicit(&m_rules, std::memory_order_acquire);
+    }
+
+    void SimulationControls::publishInjectionRules(InjectionRuleSet next)
+    {
+        next.version = rulesVersion.load(std::memory_order_relaxed) + 1;
+        const auto version = next.version;
+        std::atomic_store_explicit(&m_rules, std::shared_ptr<const InjectionRuleSet>(
+                                                 std::make_shared<InjectionRuleSet>(std::move(next))),
+                                   std::memory_order_release);
+        rulesVersion.store(version, std::memory_order_release);
+    }
 
     EngineContext::~EngineContext() = default;
 
@@ -0,0 +1,83 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace trdp_sim::util
+{
+
+    std::size_t LatencyHistogram::bucketFor(uint64_t valueUs)
+    {
+        if (valueUs < kSubBuckets)
+            return static_cast<std::size_t>(valueUs);
+
+        unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(valueUs));
+        if (exponent > kMaxExponent)
+            return kBuckets - 1;
+        // [2^e, 2^(e+1)) is split into kSubBuckets slices of width 2^(e - kSubBucketBits).
+        const auto sub = (valueUs >> (exponent - kSubBucketBits)) - kSubBuckets;
+        return static_cast<std::size_t>((exponent - kSubBucketBits + 1) * kSubBuckets + sub);
+    }
+
+    uint64_t LatencyHistogram::bucketUpperBound(std::size_t index)
+    {
+        if (index < kSubBuckets)
+            return index;
+        const auto exponent = static_cast<unsigned>(index / kSubBuckets) + kSubBucketBits - 1;
+        const auto sub      = index % kSubBuckets + kSubBuckets;
+        return ((sub + 1) << (exponent - kSubBucketBits)) - 1;
+    }
+
+    void LatencyHistogram::record(uint64_t valueUs)
+    {
+        m_counts[bucketFor(valueUs)].fetch_add(1, std::memory_order_relaxed);
+        auto prev = m_maxUs.load(std::memory_order_relaxed);
+        while (valueUs > prev && !m_maxUs.compare_exchange_weak(prev, valueUs, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+    {
+        Snapshot out;
+        for (std::size_t i = 0; i < kBuckets; ++i)
+        {
+            out.counts[i] = m_counts[i].load(std::memory_order_relaxed);
+            out.samples += out.counts[i];
+        }
+        out.maxUs = m_maxUs.load(std::memory_order_relaxed);
+        return out;
+    }
+
+    void LatencyHistogram::reset()
+    {
+        for (auto& c : m_counts)
+            c.store(0, std::memory_order_relaxed);
+        m_maxUs.store(0, std::memory_order_relaxed);
+    }
+
+    void LatencyHistogram::Snapshot::merge(const Snapshot& other)
+    {
+        for (std::size_t i = 0; i < kBuckets; ++i)
+            counts[i] += other.counts[i];
+        samples += other.samples;
+        maxUs = std::max(maxUs, other.maxUs);
+    }
+
+    double LatencyHistogram::Snapshot::percentile(double q) const
+    {
+        if (samples == 0)
+            return 0.0;
+        const auto rank =
+            std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(samples))));
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i)
+        {
+            seen += counts[i];
+            if (seen >= rank)
+                return static_cast<double>(std::min(bucketUpperBound(i), maxUs));
+        }
+        return static_cast<double>(maxUs);
+    }
+
+} // namespace trdp_sim::util
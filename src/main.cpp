@@ -7,6 +7,7 @@
 #include "realtime_stream.hpp"
 #include "md_engine.hpp"
 #include "pd_engine.hpp"
+#include "performance_harness.hpp"
 #include "trdp_adapter.hpp"
 #include "xml_loader.hpp"
 #include "config_manager.hpp"
@@ -18,10 +19,13 @@
 #include <cctype>
 #include <cstdlib>
 #include <filesystem>
+#include <iostream>
+#include <limits>
 #include <mutex>
 #include <optional>
 #include <string>
 #include <sstream>
+#include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
@@ -39,6 +43,13 @@ int main(int argc, char* argv[])
     std::optional<std::size_t> pcapMaxFilesOverride;
     std::optional<bool>        pcapRxOverride;
     std::optional<bool>        pcapTxOverride;
+    std::optional<std::string> pdCycleModeOverride;
+    std::optional<std::string> pdCatchUpOverride;
+    std::optional<bool>        pdRealtimeOverride;
+    std::optional<int>         pdCpuOverride;
+    std::optional<std::size_t> pdWorkersOverride;
+    std::optional<std::string> pdShardByOverride;
+    std::optional<std::string> pdSaturationBench;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -83,6 +94,34 @@ int main(int argc, char* argv[])
             pcapTxOverride = true;
             pcapRxOverride = true;
         }
+        else if (arg == "--pd-cycle-mode" && i + 1 < argc)
+        {
+            pdCycleModeOverride = argv[++i];
+        }
+        else if (arg == "--pd-catch-up" && i + 1 < argc)
+        {
+            pdCatchUpOverride = argv[++i];
+        }
+        else if (arg == "--pd-realtime")
+        {
+            pdRealtimeOverride = true;
+        }
+        else if (arg == "--pd-cpu" && i + 1 < argc)
+        {
+            pdCpuOverride = std::stoi(argv[++i]);
+        }
+        else if (arg == "--pd-workers" && i + 1 < argc)
+        {
+            pdWorkersOverride = std::stoull(argv[++i]);
+        }
+        else if (arg == "--pd-shard-by" && i + 1 < argc)
+        {
+            pdShardByOverride = argv[++i];
+        }
+        else if (arg == "--pd-saturation-bench" && i + 1 < argc)
+        {
+            pdSaturationBench = argv[++i];
+        }
     }
 
     const auto getEnvOrDefault = [](const std::string& key, const std::string& def) {
@@ -245,6 +284,54 @@ int main(int argc, char* argv[])
                                                             ? "ERROR"
                                                             : "FATAL"));
 
+    engine::pd::PdTimingConfig pdTiming{};
+    if (!pdCycleModeOverride)
+        pdCycleModeOverride = getEnv("TRDP_PD_CYCLE_MODE");
+    if (!pdCatchUpOverride)
+        pdCatchUpOverride = getEnv("TRDP_PD_CATCH_UP");
+    if (pdCycleModeOverride)
+        pdTiming.mode = *pdCycleModeOverride == "absolute" ? engine::pd::PdTimingConfig::CycleMode::ABSOLUTE
+                                                           : engine::pd::PdTimingConfig::CycleMode::RELATIVE;
+    if (pdCatchUpOverride)
+        pdTiming.catchUp = *pdCatchUpOverride == "burst" ? engine::pd::PdTimingConfig::CatchUpPolicy::BURST
+                                                         : engine::pd::PdTimingConfig::CatchUpPolicy::SKIP;
+    if (auto envPhasing = getEnv("TRDP_PD_PHASING"))
+        pdTiming.phasing = *envPhasing == "aligned"          ? engine::pd::PdTimingConfig::Phasing::ALIGNED
+                           : *envPhasing == "offset-address" ? engine::pd::PdTimingConfig::Phasing::OFFSET_ADDRESS
+                                                             : engine::pd::PdTimingConfig::Phasing::STAGGER;
+    if (auto envBurst = getEnv("TRDP_PD_MAX_BURST_CYCLES"))
+        pdTiming.maxBurstCycles = static_cast<uint32_t>(std::stoul(*envBurst));
+    pdEngine.setTimingConfig(pdTiming);
+
+    engine::pd::PdRealtimeConfig pdRealtime{};
+    pdRealtime.enabled    = pdRealtimeOverride ? *pdRealtimeOverride : parseBoolEnv(getEnv("TRDP_PD_REALTIME"), false);
+    pdRealtime.lockMemory = parseBoolEnv(getEnv("TRDP_PD_MLOCK"), true);
+    if (pdCpuOverride)
+        pdRealtime.cpu = *pdCpuOverride;
+    else if (auto envCpu = getEnv("TRDP_PD_CPU"))
+        pdRealtime.cpu = std::stoi(*envCpu);
+    pdEngine.setRealtimeConfig(pdRealtime);
+
+    engine::pd::PdShardingConfig pdSharding{};
+    if (!pdWorkersOverride)
+        if (auto envWorkers = getEnv("TRDP_PD_WORKERS"))
+            pdWorkersOverride = std::stoull(*envWorkers);
+    if (!pdShardByOverride)
+        pdShardByOverride = getEnv("TRDP_PD_SHARD_BY");
+    if (pdWorkersOverride)
+        pdSharding.workers = *pdWorkersOverride;
+    if (pdShardByOverride && *pdShardByOverride == "comid")
+        pdSharding.partition = engine::pd::PdShardingConfig::Partition::COMID_HASH;
+    pdEngine.setShardingConfig(pdSharding);
+
+    engine::pd::PdRxConfig pdRx{};
+    pdRx.handoff = parseBoolEnv(getEnv("TRDP_PD_RX_HANDOFF"), true);
+    if (auto envSlots = getEnv("TRDP_PD_RX_RING_SLOTS"))
+        pdRx.ringSlots = std::stoull(*envSlots);
+    if (auto envDecode = getEnv("TRDP_PD_DECODE_HZ"))
+        pdRx.decodeRateHz = std::stod(*envDecode);
+    pdEngine.setRxConfig(pdRx);
+
     trdp_sim::BackendEngine backend(ctx, pdEngine, mdEngine, diagMgr);
     backend.applyPreloadedConfiguration(ctx.deviceConfig, false);
 
@@ -256,14 +343,29 @@ int main(int argc, char* argv[])
     hub.start();
 
     ctx.running = true;
-    std::thread trdpThread(
-        [&]()
+    std::thread trdpThread([&]() { adapter.runEventLoop(); });
+
+    // Capacity probe: print the saturation report as JSON and exit without serving HTTP.
+    if (pdSaturationBench)
+    {
+        trdp_sim::perf::SaturationConfig satCfg{};
+        satCfg.platform =
+            *pdSaturationBench == "pi" ? trdp_sim::perf::Platform::RaspberryPi : trdp_sim::perf::Platform::VM;
+        int exitCode = 1;
+        if (backend.startTransport())
         {
-            while (ctx.running)
-            {
-                adapter.processOnce();
-            }
-        });
+            std::cout << trdp_sim::perf::runPdSaturation(ctx, pdEngine, satCfg).toJson() << std::endl;
+            exitCode = 0;
+        }
+        ctx.running = false;
+        adapter.stopEventLoop();
+        if (trdpThread.joinable())
+            trdpThread.join();
+        backend.stopTransport();
+        hub.stop();
+        diagMgr.stop();
+        return exitCode;
+    }
 
     // ---------------- Drogon HTTP endpoints ----------------
     auto jsonResponse = [](const nlohmann::json& payload, drogon::HttpStatusCode code = k200OK)
@@ -1033,6 +1135,35 @@ int main(int argc, char* argv[])
             mode.pdBurstTelegrams = json->get("pdBurst", 0).asUInt();
             mode.mdBurst          = json->get("mdBurst", 0).asUInt();
             mode.mdIntervalUs     = json->get("mdIntervalUs", 0).asUInt();
+            const auto& rates     = (*json)["pdRates"];
+            if (rates.isObject())
+            {
+                auto targets = std::make_shared<trdp_sim::SimulationControls::PdRateTargets>();
+                try
+                {
+                    const auto& comIds     = rates["comIds"];
+                    const auto& interfaces = rates["interfaces"];
+                    if ((!comIds.isNull() && !comIds.isObject()) || (!interfaces.isNull() && !interfaces.isObject()))
+                        throw std::invalid_argument("pdRates");
+                    for (const auto& key : comIds.getMemberNames())
+                    {
+                        std::size_t pos{0};
+                        const auto  comId = std::stoull(key, &pos);
+                        if (key.empty() || !std::isdigit(static_cast<unsigned char>(key.front())) ||
+                            pos != key.size() || comId > std::numeric_limits<uint32_t>::max())
+                            throw std::out_of_range("comId");
+                        targets->perComId[static_cast<uint32_t>(comId)] = comIds[key].asDouble();
+                    }
+                    for (const auto& key : interfaces.getMemberNames())
+                        targets->perInterface[key] = interfaces[key].asDouble();
+                }
+                catch (const std::exception&)
+                {
+                    cb(jsonResponse({{"error", "invalid pdRates"}}, k400BadRequest));
+                    return;
+                }
+                mode.pdRates = std::move(targets);
+            }
             api.setStressMode(mode);
             cb(jsonResponse(api.getSimulationState()));
         },
@@ -1374,6 +1505,7 @@ int main(int argc, char* argv[])
 
     // Cleanup
     ctx.running = false;
+    adapter.stopEventLoop();
     if (trdpThread.joinable())
         trdpThread.join();
     pdEngine.stop();
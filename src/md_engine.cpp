@@ -29,15 +29,41 @@ namespace engine::md
             std::memcpy(&dst, &src, sizeof(TRDP_UUID_T));
         }
 
+        std::array<uint8_t, sizeof(TRDP_UUID_T)> uuidKey(const TRDP_UUID_T& id)
+        {
+            std::array<uint8_t, sizeof(TRDP_UUID_T)> key{};
+            std::memcpy(key.data(), &id, key.size());
+            return key;
+        }
+
+        // No TRDP session assigned yet (or a stub indication without one).
+        bool isNilUuid(const std::array<uint8_t, sizeof(TRDP_UUID_T)>& key)
+        {
+            return std::all_of(key.begin(), key.end(), [](uint8_t b) { return b == 0; });
+        }
+
         constexpr auto kMinTcpDispatchInterval = std::chrono::milliseconds(50);
+        // Timer ids with this bit release a paced dispatch; the low bits are the session id.
+        constexpr uint64_t kDispatchTimer = uint64_t{1} << 32;
+        // Longest MD thread sleep without a timer; bounds how late stress mode notices a change.
+        constexpr auto kIdlePoll = std::chrono::milliseconds(50);
 
-        std::optional<Rule> findRule(const trdp_sim::EngineContext& ctx, uint32_t comId)
+        const Rule* findRule(const trdp_sim::SimulationControls::InjectionRuleSet& rules, uint32_t comId)
         {
-            std::lock_guard<std::mutex> lk(ctx.simulation.mtx);
-            auto                        it = ctx.simulation.mdRules.find(comId);
-            if (it != ctx.simulation.mdRules.end())
-                return it->second;
-            return std::nullopt;
+            auto it = rules.mdRules.find(comId);
+            return it != rules.mdRules.end() ? &it->second : nullptr;
+        }
+
+        // The session's rule, re-resolved only after the rules were republished. Callers hold session.mtx.
+        const Rule* cachedRule(const trdp_sim::EngineContext& ctx, MdSessionRuntime& session)
+        {
+            auto& cache = session.injection;
+            if (cache.version == ctx.simulation.rulesVersion.load(std::memory_order_acquire))
+                return cache.rule;
+            cache.rules   = ctx.simulation.injectionRules();
+            cache.version = cache.rules->version;
+            cache.rule    = findRule(*cache.rules, session.comId);
+            return cache.rule;
         }
 
         bool shouldDrop(const Rule& rule)
@@ -49,10 +75,9 @@ namespace engine::md
             return dist(rng) < rule.lossRate;
         }
 
-        void applyDelay(const Rule& rule)
+        std::chrono::steady_clock::time_point releaseTime(const Rule& rule)
         {
-            if (rule.delayMs > 0)
-                std::this_thread::sleep_for(std::chrono::milliseconds(rule.delayMs));
+            return std::chrono::steady_clock::now() + std::chrono::milliseconds(rule.delayMs);
         }
     } // namespace
 
@@ -67,9 +92,19 @@ namespace engine::md
 
     void MdEngine::initializeFromConfig()
     {
+        // Delayed releases refer to sessions by id; ids restart with the new configuration.
+        m_release.stop();
         std::lock_guard<std::mutex> lock(m_sessionsMtx);
         m_telegramByComId.clear();
         m_ctx.mdSessions.clear();
+        {
+            std::lock_guard<std::mutex> uuidLock(m_uuidMtx);
+            m_sessionByUuid.clear();
+        }
+        {
+            std::lock_guard<std::mutex> timerLock(m_timerMtx);
+            m_timers.clear();
+        }
         m_nextSessionId = 1;
         buildSessionsFromConfig();
     }
@@ -84,11 +119,26 @@ namespace engine::md
 
     void MdEngine::stop()
     {
-        if (!m_running.exchange(false))
-            return;
+        m_release.stop();
+        if (m_running.exchange(false))
+        {
+            {
+                std::lock_guard<std::mutex> lk(m_timerMtx);
+                m_timerCv.notify_all();
+            }
+            if (m_thread.joinable())
+                m_thread.join();
+        }
 
-        if (m_thread.joinable())
-            m_thread.join();
+        // Paced dispatches waiting on the MD thread are dropped, like delayed releases above.
+        std::lock_guard<std::mutex> lock(m_sessionsMtx);
+        for (auto& [_, sessPtr] : m_ctx.mdSessions)
+        {
+            if (!sessPtr)
+                continue;
+            std::lock_guard<std::mutex> lk(sessPtr->mtx);
+            sessPtr->pendingDispatch = MdPendingDispatch::NONE;
+        }
     }
 
     uint32_t MdEngine::createRequestSession(uint32_t comId)
@@ -190,7 +240,27 @@ namespace engine::md
 
     void MdEngine::onMdIndication(const TRDP_MD_INFO_T* info, const uint8_t* data, std::size_t len)
     {
-        (void) len;
+        const auto  rules = m_ctx.simulation.injectionRules();
+        const Rule* rule  = findRule(*rules, info ? info->comId : 0);
+        if (rule && shouldDrop(*rule))
+            return;
+        if (rule && rule->delayMs > 0)
+        {
+            // Park a copy instead of stalling the TRDP callback thread.
+            std::optional<TRDP_MD_INFO_T> infoCopy;
+            if (info)
+                infoCopy = *info;
+            std::vector<uint8_t> bytes(data, data + (data ? len : 0));
+            m_release.schedule(releaseTime(*rule), [this, infoCopy, bytes = std::move(bytes)]() {
+                deliverIndication(infoCopy ? &*infoCopy : nullptr, bytes.data(), bytes.size());
+            });
+            return;
+        }
+        deliverIndication(info, data, len);
+    }
+
+    void MdEngine::deliverIndication(const TRDP_MD_INFO_T* info, const uint8_t* data, std::size_t len)
+    {
         MdIndicationContext ctx;
         if (info)
         {
@@ -200,14 +270,6 @@ namespace engine::md
             ctx.resultCode = info->resultCode;
         }
 
-        const auto rule = findRule(m_ctx, ctx.comId);
-        if (rule)
-        {
-            if (shouldDrop(*rule))
-                return;
-            applyDelay(*rule);
-        }
-
         auto opt = getSessionByTrdpSession(ctx.trdpSessionId);
         if (!opt)
         {
@@ -249,6 +311,7 @@ namespace engine::md
             copyUuid(sess->trdpSessionId, ctx.trdpSessionId);
 
             const auto internalId = sess->sessionId;
+            indexTrdpSession(*sess, UuidKey{});
             m_ctx.mdSessions[internalId] = std::move(sess);
             ctx.sessionId                 = internalId;
             opt                           = m_ctx.mdSessions.find(internalId)->second.get();
@@ -277,6 +340,7 @@ namespace engine::md
             {
                 auto rtt = std::chrono::duration_cast<std::chrono::microseconds>(now - sess->stats.lastTxTime);
                 sess->stats.lastRoundTripUs = static_cast<uint64_t>(rtt.count());
+                sess->roundTripHist.record(sess->stats.lastRoundTripUs);
             }
             sess->lastResponseWall = now;
         }
@@ -315,6 +379,21 @@ namespace engine::md
 
     std::optional<MdSessionRuntime*> MdEngine::getSessionByTrdpSession(const TRDP_UUID_T& trdpSessionId)
     {
+        const auto key = uuidKey(trdpSessionId);
+        if (!isNilUuid(key))
+        {
+            uint32_t sessionId = 0;
+            {
+                std::lock_guard<std::mutex> uuidLock(m_uuidMtx);
+                auto                        it = m_sessionByUuid.find(key);
+                if (it == m_sessionByUuid.end())
+                    return std::nullopt;
+                sessionId = it->second;
+            }
+            return getSession(sessionId);
+        }
+
+        // Sessions that never sent anything have no UUID yet; only those can match a nil one.
         std::lock_guard<std::mutex> lock(m_sessionsMtx);
         for (auto& [_, sessPtr] : m_ctx.mdSessions)
         {
@@ -326,6 +405,30 @@ namespace engine::md
         return std::nullopt;
     }
 
+    std::size_t MdEngine::UuidKeyHash::operator()(const UuidKey& key) const
+    {
+        // UUIDs are close to random already; fold the two halves.
+        uint64_t halves[2]{};
+        std::memcpy(halves, key.data(), std::min(sizeof(halves), key.size()));
+        return static_cast<std::size_t>(halves[0] ^ (halves[1] * 0x9E3779B97F4A7C15ull));
+    }
+
+    void MdEngine::indexTrdpSession(const MdSessionRuntime& session, const UuidKey& previous)
+    {
+        const auto key = uuidKey(session.trdpSessionId);
+        if (key == previous)
+            return;
+        std::lock_guard<std::mutex> uuidLock(m_uuidMtx);
+        if (!isNilUuid(previous))
+        {
+            auto it = m_sessionByUuid.find(previous);
+            if (it != m_sessionByUuid.end() && it->second == session.sessionId)
+                m_sessionByUuid.erase(it);
+        }
+        if (!isNilUuid(key))
+            m_sessionByUuid[key] = session.sessionId;
+    }
+
     void MdEngine::forEachSession(const std::function<void(const MdSessionRuntime&)>& fn)
     {
         std::lock_guard<std::mutex> lock(m_sessionsMtx);
@@ -374,9 +477,10 @@ namespace engine::md
 
     void MdEngine::runLoop()
     {
+        auto lastBurst = std::chrono::steady_clock::now();
         while (m_running.load())
         {
-            handleTimeouts();
+            handleTimeouts(std::chrono::steady_clock::now());
             trdp_sim::SimulationControls::StressMode stress{};
             {
                 std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
@@ -386,7 +490,6 @@ namespace engine::md
                 std::chrono::microseconds(trdp_sim::SimulationControls::StressMode::kMinCycleUs);
             if (stress.enabled && stress.mdBurst > 0)
             {
-                static auto lastBurst = std::chrono::steady_clock::now();
                 auto interval = std::chrono::microseconds(
                     stress.mdIntervalUs == 0 ? trdp_sim::SimulationControls::StressMode::kMinCycleUs : stress.mdIntervalUs);
                 if (interval < intervalMin)
@@ -425,70 +528,134 @@ namespace engine::md
                     }
                 }
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+            // Sleep until the next deadline; arming an earlier one wakes us.
+            std::unique_lock<std::mutex> lk(m_timerMtx);
+            if (!m_running.load())
+                break;
+            auto wakeAt = std::chrono::steady_clock::now() + kIdlePoll;
+            if (auto next = m_timers.nextExpiry(); next && *next < wakeAt)
+                wakeAt = *next;
+            m_timerWakeAt = wakeAt;
+            m_timerCv.wait_until(lk, wakeAt);
+            m_timerWakeAt = std::chrono::steady_clock::time_point::min();
         }
     }
 
-    void MdEngine::handleTimeouts()
+    void MdEngine::armDeadlineLocked(const MdSessionRuntime& session)
     {
-        const auto            now = std::chrono::steady_clock::now();
-        std::vector<uint32_t> retryIds;
+        armTimer(session.sessionId, session.deadline);
+    }
 
-        {
-            std::lock_guard<std::mutex> lock(m_sessionsMtx);
-            for (const auto& [id, sessPtr] : m_ctx.mdSessions)
-            {
-                if (!sessPtr)
-                    continue;
+    void MdEngine::armTimer(uint64_t id, std::chrono::steady_clock::time_point due)
+    {
+        std::lock_guard<std::mutex> lk(m_timerMtx);
+        m_timers.schedule(id, due);
+        if (due < m_timerWakeAt)
+            m_timerCv.notify_one();
+    }
 
-                std::unique_lock<std::mutex> lk(sessPtr->mtx, std::try_to_lock);
-                if (!lk.owns_lock())
-                    continue;
+    bool MdEngine::deferTcpDispatchLocked(MdSessionRuntime& session, MdPendingDispatch kind)
+    {
+        if (session.pendingDispatch != MdPendingDispatch::NONE)
+            return true; // the queued dispatch marshals the latest data when it goes out
+        if (session.proto != MdProtocol::TCP || session.stats.lastTxTime.time_since_epoch().count() == 0)
+            return false;
+
+        const auto now       = std::chrono::steady_clock::now();
+        const auto notBefore = session.stats.lastTxTime + kMinTcpDispatchInterval;
+        if (now >= notBefore)
+            return false;
+
+        session.pendingDispatch = kind;
+        session.stats.pacedDispatches++;
+        if (kind == MdPendingDispatch::REQUEST)
+        {
+            session.state           = MdSessionState::REQUEST_SENT;
+            session.lastStateChange = now;
+        }
+        if (m_running.load())
+        {
+            armTimer(kDispatchTimer | session.sessionId, notBefore);
+        }
+        else
+        {
+            // No MD thread to release it; the release queue's worker sends it instead.
+            m_release.schedule(notBefore, [this, id = session.sessionId]() { runPendingDispatch(id); });
+        }
+        return true;
+    }
 
-                if ((sessPtr->state == MdSessionState::WAITING_REPLY ||
-                     sessPtr->state == MdSessionState::WAITING_ACK) &&
-                    sessPtr->deadline.time_since_epoch().count() == 0)
-                {
-                    continue;
-                }
+    void MdEngine::runPendingDispatch(uint32_t sessionId)
+    {
+        auto opt = getSession(sessionId);
+        if (!opt)
+            return;
+        auto*                       sess = *opt;
+        std::lock_guard<std::mutex> lk(sess->mtx);
+        const auto                  kind = sess->pendingDispatch;
+        sess->pendingDispatch            = MdPendingDispatch::NONE;
+        if (kind == MdPendingDispatch::REQUEST)
+            dispatchRequestLocked(*sess);
+        else if (kind == MdPendingDispatch::REPLY)
+            dispatchReplyLocked(*sess);
+    }
 
-                if (sessPtr->state == MdSessionState::WAITING_REPLY && sessPtr->deadline <= now)
-                {
-                    if (sessPtr->mdCom && sessPtr->retryCount < sessPtr->mdCom->retries)
-                    {
-                        sessPtr->retryCount++;
-                        sessPtr->stats.retryCount++;
-                        sessPtr->deadline = now + std::chrono::microseconds(sessPtr->mdCom->replyTimeoutUs);
-                        retryIds.push_back(id);
-                    }
-                    else
-                    {
-                        sessPtr->state = MdSessionState::TIMEOUT;
-                        sessPtr->stats.timeoutCount++;
-                    }
-                }
-                else if (sessPtr->state == MdSessionState::WAITING_ACK && sessPtr->deadline <= now)
-                {
-                    sessPtr->state = MdSessionState::TIMEOUT;
-                    sessPtr->stats.timeoutCount++;
-                }
-            }
+    void MdEngine::handleTimeouts(std::chrono::steady_clock::time_point now)
+    {
+        std::vector<uint64_t> expired;
+        {
+            std::lock_guard<std::mutex> lk(m_timerMtx);
+            m_timers.expire(now, expired);
         }
 
-        for (auto id : retryIds)
+        // Only sessions whose timer fired are visited; a reply that already arrived leaves a stale
+        // timer that finds the session in another state.
+        for (auto id : expired)
         {
-            auto opt = getSession(id);
+            if (id & kDispatchTimer)
+            {
+                runPendingDispatch(static_cast<uint32_t>(id));
+                continue;
+            }
+            auto opt = getSession(static_cast<uint32_t>(id));
             if (!opt)
                 continue;
             auto*                       sess = *opt;
             std::lock_guard<std::mutex> lk(sess->mtx);
-            dispatchRequestLocked(*sess);
+            if (sess->deadline.time_since_epoch().count() == 0)
+                continue;
+            if (sess->deadline > now)
+            {
+                armDeadlineLocked(*sess);
+                continue;
+            }
+
+            if (sess->state == MdSessionState::WAITING_REPLY)
+            {
+                if (sess->mdCom && sess->retryCount < sess->mdCom->retries)
+                {
+                    sess->retryCount++;
+                    sess->stats.retryCount++;
+                    dispatchRequestLocked(*sess);
+                }
+                else
+                {
+                    sess->state = MdSessionState::TIMEOUT;
+                    sess->stats.timeoutCount++;
+                }
+            }
+            else if (sess->state == MdSessionState::WAITING_ACK)
+            {
+                sess->state = MdSessionState::TIMEOUT;
+                sess->stats.timeoutCount++;
+            }
         }
     }
 
     void MdEngine::dispatchRequestLocked(MdSessionRuntime& session)
     {
-        if (!session.requestData)
+        if (!session.requestData || deferTcpDispatchLocked(session, MdPendingDispatch::REQUEST))
             return;
 
         std::vector<uint8_t> payload;
@@ -496,14 +663,7 @@ namespace engine::md
             std::lock_guard<std::mutex> dsLock(session.requestData->mtx);
             payload = marshalDataSet(*session.requestData, m_ctx);
         }
-        if (session.proto == MdProtocol::TCP && session.stats.lastTxTime.time_since_epoch().count() != 0)
-        {
-            const auto now     = std::chrono::steady_clock::now();
-            const auto elapsed = now - session.stats.lastTxTime;
-            if (elapsed < kMinTcpDispatchInterval)
-                std::this_thread::sleep_for(kMinTcpDispatchInterval - elapsed);
-        }
-        const auto rule = findRule(m_ctx, session.comId);
+        const Rule* rule = cachedRule(m_ctx, session);
         if (rule)
         {
             if (shouldDrop(*rule))
@@ -511,14 +671,34 @@ namespace engine::md
                 session.state = MdSessionState::TIMEOUT;
                 return;
             }
-            applyDelay(*rule);
             if (rule->corruptDataSetId && !payload.empty())
                 payload[0] = static_cast<uint8_t>(payload[0] ^ 0xFF);
             if (rule->corruptComId)
                 payload.insert(payload.begin(), 0xCD);
+            if (rule->delayMs > 0)
+            {
+                session.state           = MdSessionState::REQUEST_SENT;
+                session.lastStateChange = std::chrono::steady_clock::now();
+                m_release.schedule(releaseTime(*rule), [this, id = session.sessionId, payload = std::move(payload)]() {
+                    auto opt = getSession(id);
+                    if (!opt)
+                        return;
+                    std::lock_guard<std::mutex> lk((*opt)->mtx);
+                    sendRequestPayloadLocked(**opt, payload);
+                });
+                return;
+            }
         }
+        sendRequestPayloadLocked(session, payload);
+    }
+
+    void MdEngine::sendRequestPayloadLocked(MdSessionRuntime& session, const std::vector<uint8_t>& payload)
+    {
         session.lastRequestPayload = payload;
-        int rc = m_adapter.sendMdRequest(session, payload);
+        const auto previousUuid    = uuidKey(session.trdpSessionId);
+        int        rc              = m_adapter.sendMdRequest(session, payload);
+        // The stack hands out a new session UUID per request; replies are matched on it.
+        indexTrdpSession(session, previousUuid);
         if (rc != 0)
         {
             session.state = MdSessionState::ERROR;
@@ -533,13 +713,16 @@ namespace engine::md
         session.stats.lastRoundTripUs = 0;
         session.state            = MdSessionState::WAITING_REPLY;
         if (session.mdCom)
+        {
             session.deadline = now + std::chrono::microseconds(session.mdCom->replyTimeoutUs);
+            armDeadlineLocked(session);
+        }
         session.lastStateChange = now;
     }
 
     void MdEngine::dispatchReplyLocked(MdSessionRuntime& session)
     {
-        if (!session.responseData)
+        if (!session.responseData || deferTcpDispatchLocked(session, MdPendingDispatch::REPLY))
             return;
 
         std::vector<uint8_t> payload;
@@ -547,14 +730,7 @@ namespace engine::md
             std::lock_guard<std::mutex> dsLock(session.responseData->mtx);
             payload = marshalDataSet(*session.responseData, m_ctx);
         }
-        if (session.proto == MdProtocol::TCP && session.stats.lastTxTime.time_since_epoch().count() != 0)
-        {
-            const auto now     = std::chrono::steady_clock::now();
-            const auto elapsed = now - session.stats.lastTxTime;
-            if (elapsed < kMinTcpDispatchInterval)
-                std::this_thread::sleep_for(kMinTcpDispatchInterval - elapsed);
-        }
-        const auto rule = findRule(m_ctx, session.comId);
+        const Rule* rule = cachedRule(m_ctx, session);
         if (rule)
         {
             if (shouldDrop(*rule))
@@ -562,12 +738,27 @@ namespace engine::md
                 session.state = MdSessionState::TIMEOUT;
                 return;
             }
-            applyDelay(*rule);
             if (rule->corruptDataSetId && !payload.empty())
                 payload[0] = static_cast<uint8_t>(payload[0] ^ 0xFF);
             if (rule->corruptComId)
                 payload.insert(payload.begin(), 0xCD);
+            if (rule->delayMs > 0)
+            {
+                m_release.schedule(releaseTime(*rule), [this, id = session.sessionId, payload = std::move(payload)]() {
+                    auto opt = getSession(id);
+                    if (!opt)
+                        return;
+                    std::lock_guard<std::mutex> lk((*opt)->mtx);
+                    sendReplyPayloadLocked(**opt, payload);
+                });
+                return;
+            }
         }
+        sendReplyPayloadLocked(session, payload);
+    }
+
+    void MdEngine::sendReplyPayloadLocked(MdSessionRuntime& session, const std::vector<uint8_t>& payload)
+    {
         session.lastResponsePayload = payload;
         int rc = m_adapter.sendMdReply(session, payload);
         if (rc != 0)
@@ -582,7 +773,10 @@ namespace engine::md
         session.stats.lastTxTime = now;
         session.state            = MdSessionState::WAITING_ACK;
         if (session.mdCom)
+        {
             session.deadline = now + std::chrono::microseconds(session.mdCom->confirmTimeoutUs);
+            armDeadlineLocked(session);
+        }
         session.lastStateChange = now;
     }
 
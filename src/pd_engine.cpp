@@ -4,9 +4,17 @@
 #include "trdp_adapter.hpp"
 
 #include <arpa/inet.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
 #include <algorithm>
+#include <cerrno>
 #include <chrono>
 #include <cmath>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -37,16 +45,28 @@ namespace engine::pd
             return static_cast<TRDP_IP_ADDR_T>(ntohl(addr.s_addr));
         }
 
-        std::optional<Rule> findRule(const trdp_sim::EngineContext& ctx, uint32_t comId, uint32_t dataSetId)
+        const Rule* findRule(const trdp_sim::SimulationControls::InjectionRuleSet& rules, uint32_t comId,
+                             uint32_t dataSetId)
         {
-            std::lock_guard<std::mutex> lk(ctx.simulation.mtx);
-            auto                        it = ctx.simulation.pdRules.find(comId);
-            if (it != ctx.simulation.pdRules.end())
-                return it->second;
-            auto dsIt = ctx.simulation.dataSetRules.find(dataSetId);
-            if (dsIt != ctx.simulation.dataSetRules.end())
-                return dsIt->second;
-            return std::nullopt;
+            auto it = rules.pdRules.find(comId);
+            if (it != rules.pdRules.end())
+                return &it->second;
+            auto dsIt = rules.dataSetRules.find(dataSetId);
+            if (dsIt != rules.dataSetRules.end())
+                return &dsIt->second;
+            return nullptr;
+        }
+
+        // The telegram's rule, re-resolved only after the rules were republished. Callers hold pd.mtx.
+        const Rule* cachedRule(const trdp_sim::EngineContext& ctx, PdTelegramRuntime& pd)
+        {
+            auto& cache = pd.injection;
+            if (cache.version == ctx.simulation.rulesVersion.load(std::memory_order_acquire))
+                return cache.rule;
+            cache.rules   = ctx.simulation.injectionRules();
+            cache.version = cache.rules->version;
+            cache.rule    = findRule(*cache.rules, pd.cfg->comId, pd.cfg->dataSetId);
+            return cache.rule;
         }
 
         bool shouldDrop(const Rule& rule)
@@ -58,10 +78,150 @@ namespace engine::pd
             return dist(rng) < rule.lossRate;
         }
 
-        void applyDelay(const Rule& rule)
+        std::chrono::steady_clock::time_point releaseTime(const Rule& rule)
         {
-            if (rule.delayMs > 0)
-                std::this_thread::sleep_for(std::chrono::milliseconds(rule.delayMs));
+            return std::chrono::steady_clock::now() + std::chrono::milliseconds(rule.delayMs);
+        }
+
+        // Retry granularity, matching the legacy 1 ms publisher tick.
+        constexpr auto kRetryInterval = std::chrono::milliseconds(1);
+        // Bound on an RX worker sleep in case a wakeup is ever missed.
+        constexpr auto kRxIdleWait = std::chrono::milliseconds(100);
+        // Frames taken from one ring before moving to the next, so a busy interface cannot starve the others.
+        constexpr std::size_t kRxDrainBatch = 64;
+
+        std::chrono::microseconds effectiveCycle(const PdTelegramRuntime& pd, uint32_t cycleOverrideUs)
+        {
+            using std::chrono::microseconds;
+            constexpr auto kMinCycleUs = trdp_sim::SimulationControls::StressMode::kMinCycleUs;
+
+            auto cycle = microseconds(pd.cfg->pdParam->cycleUs);
+            if (cycleOverrideUs > 0)
+            {
+                auto overrideCycle = microseconds(std::max(cycleOverrideUs, static_cast<uint32_t>(kMinCycleUs)));
+                if (overrideCycle < cycle || pd.cfg->pdParam->cycleUs == 0)
+                    cycle = overrideCycle;
+            }
+            return std::max(cycle, microseconds(kMinCycleUs));
+        }
+
+        // Set the first deadline of an interface's publishers. Each group sharing a cycle is
+        // spread evenly across it in COM ID order so they do not all fire on one tick.
+        void assignPhases(std::vector<PdTelegramRuntime*> publishers, PdTimingConfig::Phasing phasing,
+                          std::chrono::steady_clock::time_point start)
+        {
+            using Phasing = PdTimingConfig::Phasing;
+
+            std::sort(publishers.begin(), publishers.end(),
+                      [](const PdTelegramRuntime* a, const PdTelegramRuntime* b)
+                      {
+                          if (a->cfg->pdParam->cycleUs != b->cfg->pdParam->cycleUs)
+                              return a->cfg->pdParam->cycleUs < b->cfg->pdParam->cycleUs;
+                          return a->cfg->comId < b->cfg->comId;
+                      });
+
+            for (std::size_t first = 0; first < publishers.size();)
+            {
+                const auto cycleUs = publishers[first]->cfg->pdParam->cycleUs;
+                auto       last    = first;
+                while (last < publishers.size() && publishers[last]->cfg->pdParam->cycleUs == cycleUs)
+                    ++last;
+
+                const auto count = static_cast<uint64_t>(last - first);
+                for (auto i = first; i < last; ++i)
+                {
+                    auto&    pd       = *publishers[i];
+                    uint64_t offsetUs = 0;
+                    if (phasing == Phasing::OFFSET_ADDRESS && pd.cfg->pdParam->offsetAddress != 0 && cycleUs > 0)
+                        offsetUs = pd.cfg->pdParam->offsetAddress % cycleUs;
+                    else if (phasing != Phasing::ALIGNED)
+                        offsetUs = static_cast<uint64_t>(cycleUs) * (i - first) / count;
+                    pd.nextDue = start + std::chrono::microseconds(offsetUs);
+                }
+                first = last;
+            }
+        }
+
+        // libstdc++'s steady_clock is CLOCK_MONOTONIC, so its epoch maps directly onto timespec.
+        void sleepUntil(std::chrono::steady_clock::time_point tp)
+        {
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+            if (ns <= 0)
+                return;
+            timespec ts{};
+            ts.tv_sec  = static_cast<time_t>(ns / 1000000000);
+            ts.tv_nsec = static_cast<long>(ns % 1000000000);
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+            {
+            }
+        }
+
+        // Account for the slot a successful send belongs to and return the next deadline.
+        // Slots that passed without a send count as missed unless BURST catches them up.
+        std::chrono::steady_clock::time_point advanceCycle(PdTelegramRuntime& pd, std::chrono::steady_clock::time_point now,
+                                                           std::chrono::microseconds cycle, const PdTimingConfig& timing)
+        {
+            using Mode = PdTimingConfig::CycleMode;
+
+            auto slot = pd.nextDue;
+            if (slot.time_since_epoch().count() == 0)
+                slot = now;
+
+            if (now < slot)
+            {
+                // Early send (triggerSendNow or stress burst); an absolute schedule keeps its phase.
+                if (timing.mode == Mode::RELATIVE)
+                    pd.nextDue = now + cycle;
+                return pd.nextDue;
+            }
+
+            const auto lateness     = now - slot;
+            const auto latenessUs   = std::chrono::duration<double, std::micro>(lateness).count();
+            pd.stats.maxLatenessUs  = std::max(pd.stats.maxLatenessUs, latenessUs);
+            pd.jitterHist.record(static_cast<uint64_t>(latenessUs));
+            const auto missed       = static_cast<uint64_t>(lateness / cycle);
+            uint64_t   catchUpSlots = 0;
+            if (timing.mode == Mode::ABSOLUTE && timing.catchUp == PdTimingConfig::CatchUpPolicy::BURST)
+                catchUpSlots = std::min<uint64_t>(missed, timing.maxBurstCycles);
+            pd.stats.missedCycles += missed - catchUpSlots;
+
+            if (timing.mode == Mode::RELATIVE)
+                pd.nextDue = now + cycle;
+            else
+                pd.nextDue = slot + cycle * static_cast<int64_t>(missed + 1 - catchUpSlots);
+            return pd.nextDue;
+        }
+
+        // Return the publisher's payload, re-marshalling only when the dataset generation
+        // moved since the last send. Callers hold pd.mtx.
+        const std::vector<uint8_t>& cachedPayloadFor(PdTelegramRuntime& pd, data::DataSetInstance& ds,
+                                                     bool shouldMarshall, const trdp_sim::EngineContext& ctx)
+        {
+            // Contiguous datasets are read from their published image without taking ds.mtx.
+            if (auto snapshot = shouldMarshall ? data::publishedSnapshot(ds) : nullptr)
+            {
+                if (pd.payloadCached && pd.cachedGeneration == snapshot->generation)
+                {
+                    pd.stats.payloadCacheHits++;
+                    return pd.cachedPayload;
+                }
+                pd.cachedPayload    = snapshot->bytes;
+                pd.cachedGeneration = snapshot->generation;
+            }
+            else
+            {
+                std::lock_guard<std::mutex> dsLock(ds.mtx);
+                if (pd.payloadCached && pd.cachedGeneration == ds.generation)
+                {
+                    pd.stats.payloadCacheHits++;
+                    return pd.cachedPayload;
+                }
+                pd.cachedPayload    = shouldMarshall ? trdp_sim::util::marshalDataSet(ds, ctx) : data::elementBytes(ds, 0);
+                pd.cachedGeneration = ds.generation;
+            }
+            pd.payloadCached = true;
+            pd.stats.payloadCacheMisses++;
+            return pd.cachedPayload;
         }
     } // namespace
 
@@ -81,12 +241,39 @@ namespace engine::pd
 
     void PdEngine::initializeFromConfig(bool activateTransport)
     {
+        // Shard threads hold raw runtime pointers; restart them around the rebuild.
+        const bool wasRunning = m_running.load();
+        stop();
+
+        m_shards.clear();
+        m_ctx.pdSubscribersByComId.clear();
+        m_subscribersByDataSet.clear();
         m_ctx.pdTelegrams.clear();
 
+        const auto sharding   = shardingConfig();
+        const auto shardCount = shardCountFor(m_ctx.deviceConfig);
+        for (std::size_t i = 0; i < shardCount; ++i)
+        {
+            auto shard         = std::make_unique<Shard>();
+            shard->index       = i;
+            shard->stats.index = i;
+            m_shards.push_back(std::move(shard));
+        }
+
+        m_rxRings.clear();
+        const auto rx = rxConfig();
+        for (std::size_t i = 0; i < std::max<std::size_t>(1, m_ctx.deviceConfig.interfaces.size()); ++i)
+            m_rxRings.push_back(std::make_unique<trdp_sim::util::SpscFrameRing>(std::max<std::size_t>(1, rx.ringSlots)));
+
+        const auto initTime = std::chrono::steady_clock::now();
+        const auto phasing  = timingConfig().phasing;
+
+        std::size_t ifaceIdx = 0;
         for (const auto& iface : m_ctx.deviceConfig.interfaces)
         {
             if (activateTransport)
                 m_adapter.applyMulticastConfig(iface);
+            std::vector<PdTelegramRuntime*> ifacePublishers;
             for (const auto& tel : iface.telegrams)
             {
                 if (!tel.pdParam)
@@ -139,26 +326,97 @@ namespace engine::pd
                         std::cerr << "Failed to publish PD COM ID " << tel.comId << " (rc=" << rc << ")" << std::endl;
                 }
 
+                rt->shard = sharding.partition == PdShardingConfig::Partition::INTERFACE
+                                ? ifaceIdx % shardCount
+                                : ((static_cast<uint64_t>(tel.comId) * 2654435761u) >> 16) % shardCount;
+                if (rt->direction == Direction::PUBLISH)
+                {
+                    auto& shard = *m_shards[rt->shard];
+                    shard.publishers.push_back(rt.get());
+                    shard.stats.publishers++;
+                    ifacePublishers.push_back(rt.get());
+                }
+                else
+                {
+                    // Timeout deadlines are armed by the first received telegram.
+                    m_ctx.pdSubscribersByComId[tel.comId].push_back(rt.get());
+                    m_subscribersByDataSet[tel.dataSetId].push_back(rt.get());
+                }
+
                 m_ctx.pdTelegrams.push_back(std::move(rt));
             }
+            assignPhases(ifacePublishers, phasing, initTime);
+            for (std::size_t i = 0; i < ifacePublishers.size(); ++i)
+            {
+                auto& pd               = *ifacePublishers[i];
+                pd.ifacePublisherIndex = i;
+                pd.ifacePublisherCount = ifacePublishers.size();
+                m_shards[pd.shard]->scheduler.arm(pd, pd.nextDue);
+            }
+            ++ifaceIdx;
         }
+
+        if (wasRunning)
+            start();
+    }
+
+    std::size_t PdEngine::shardCountFor(const config::DeviceConfig& cfg) const
+    {
+        const auto  sharding = shardingConfig();
+        std::size_t workers  = sharding.workers;
+        if (workers == 0)
+        {
+            workers = sharding.partition == PdShardingConfig::Partition::INTERFACE
+                          ? cfg.interfaces.size()
+                          : static_cast<std::size_t>(std::thread::hardware_concurrency());
+        }
+        if (sharding.partition == PdShardingConfig::Partition::INTERFACE)
+            workers = std::min(workers, cfg.interfaces.size());
+        return std::max<std::size_t>(workers, 1);
     }
 
     void PdEngine::start()
     {
-        if (m_running.exchange(true))
+        if (m_shards.empty() || m_running.exchange(true))
             return;
 
-        m_thread = std::thread(&PdEngine::runPublisherLoop, this);
+        uint32_t tickUs{0};
+        for (const auto& iface : m_ctx.deviceConfig.interfaces)
+        {
+            if (iface.trdpProcess.cycleTimeUs > 0 && (tickUs == 0 || iface.trdpProcess.cycleTimeUs < tickUs))
+                tickUs = iface.trdpProcess.cycleTimeUs;
+        }
+        m_realtimeTick = tickUs > 0 ? std::chrono::microseconds(tickUs) : kRetryInterval;
+
+        if (rxConfig().handoff)
+            startRxWorker();
+
+        for (auto& shard : m_shards)
+        {
+            {
+                std::lock_guard<std::mutex> lk(shard->mtx);
+                shard->stats.wakeup = PdWakeupStats{};
+                shard->kick         = false;
+            }
+            shard->thread = std::thread(&PdEngine::runShardLoop, this, std::ref(*shard));
+        }
     }
 
     void PdEngine::stop()
     {
+        // Frames still queued are applied here; the worker may schedule delayed releases, so it goes first.
+        stopRxWorker();
+        // Delayed releases hold runtime pointers; drop them before the runtimes can go away.
+        m_release.stop();
         if (!m_running.exchange(false))
             return;
 
-        if (m_thread.joinable())
-            m_thread.join();
+        wakeAll();
+        for (auto& shard : m_shards)
+        {
+            if (shard->thread.joinable())
+                shard->thread.join();
+        }
     }
 
     void PdEngine::enableTelegram(uint32_t comId, bool enable)
@@ -168,13 +426,27 @@ namespace engine::pd
             auto& pd = *pdPtr;
             if (pd.cfg && pd.cfg->comId == comId)
             {
-                std::lock_guard<std::mutex> lk(pd.mtx);
-                pd.enabled = enable;
-                if (m_ctx.diagManager)
                 {
-                    m_ctx.diagManager->log(diag::Severity::INFO, "PD",
-                                           std::string("PD COM ID ") + std::to_string(comId) +
-                                               (enable ? " enabled" : " disabled"));
+                    std::lock_guard<std::mutex> lk(pd.mtx);
+                    if (enable && !pd.enabled)
+                        pd.nextDue = std::chrono::steady_clock::now(); // restart the cycle phase
+                    pd.enabled = enable;
+                    if (m_ctx.diagManager)
+                    {
+                        m_ctx.diagManager->log(diag::Severity::INFO, "PD",
+                                               std::string("PD COM ID ") + std::to_string(comId) +
+                                                   (enable ? " enabled" : " disabled"));
+                    }
+                }
+                if (enable && pd.direction == Direction::PUBLISH && pd.shard < m_shards.size())
+                {
+                    auto& shard = *m_shards[pd.shard];
+                    {
+                        std::lock_guard<std::mutex> lk(shard.mtx);
+                        if (!shard.scheduler.isArmed(pd))
+                            shard.scheduler.arm(pd, std::chrono::steady_clock::now());
+                    }
+                    wake(shard);
                 }
             }
         }
@@ -185,37 +457,89 @@ namespace engine::pd
         for (auto& pdPtr : m_ctx.pdTelegrams)
         {
             auto& pd = *pdPtr;
-            if (pd.cfg && pd.cfg->comId == comId && pd.direction == Direction::PUBLISH)
+            if (pd.cfg && pd.cfg->comId == comId && pd.direction == Direction::PUBLISH && pd.shard < m_shards.size())
             {
-                std::lock_guard<std::mutex> lk(pd.mtx);
-                pd.sendNow = true;
+                {
+                    std::lock_guard<std::mutex> lk(pd.mtx);
+                    pd.sendNow = true;
+                }
+                auto& shard = *m_shards[pd.shard];
+                {
+                    std::lock_guard<std::mutex> lk(shard.mtx);
+                    shard.scheduler.arm(pd, std::chrono::steady_clock::time_point{});
+                }
+                wake(shard);
             }
         }
     }
 
     data::DataSetInstance* PdEngine::getDataSetInstance(uint32_t dataSetId)
     {
+        syncDataSet(dataSetId);
         auto it = m_ctx.dataSetInstances.find(dataSetId);
         if (it == m_ctx.dataSetInstances.end())
             return nullptr;
         return it->second.get();
     }
 
-    void PdEngine::onPdReceived(uint32_t comId, const uint8_t* data, std::size_t len)
+    void PdEngine::onPdReceived(uint32_t comId, const uint8_t* data, std::size_t len, std::size_t rxChannel)
     {
-        const auto baseRule = findRule(m_ctx, comId, 0);
-        if (baseRule)
+        const auto rxTime = std::chrono::steady_clock::now();
+        if (m_rxRunning.load(std::memory_order_acquire) && rxChannel < m_rxRings.size() &&
+            trdp_sim::util::SpscFrameRing::fits(len))
         {
-            if (shouldDrop(*baseRule))
-                return;
-            applyDelay(*baseRule);
+            // A full ring drops the frame, like a full socket buffer would; the ring counts it.
+            if (m_rxRings[rxChannel]->tryPush(comId, data, len, rxTime))
+            {
+                // Pairs with the fence in runRxLoop(): either the worker sees the frame or we see it idle.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (m_rxIdle.load(std::memory_order_relaxed))
+                {
+                    std::lock_guard<std::mutex> lk(m_rxMtx);
+                    m_rxCv.notify_one();
+                }
+            }
+            return;
+        }
+        processReceived(comId, data, len, rxTime);
+    }
+
+    void PdEngine::processReceived(uint32_t comId, const uint8_t* data, std::size_t len,
+                                   std::chrono::steady_clock::time_point rxTime)
+    {
+        auto        rules    = m_ctx.simulation.injectionRules();
+        const Rule* baseRule = findRule(*rules, comId, 0);
+        if (baseRule && shouldDrop(*baseRule))
+            return;
+        if (baseRule && baseRule->delayMs > 0)
+        {
+            // Park a copy instead of stalling the TRDP callback thread; the snapshot keeps baseRule alive.
+            std::vector<uint8_t> bytes(data, data + (data ? len : 0));
+            m_release.schedule(releaseTime(*baseRule),
+                               [this, comId, bytes = std::move(bytes), rules = std::move(rules), baseRule]() {
+                                   deliverReceived(comId, bytes.data(), bytes.size(), baseRule,
+                                                   std::chrono::steady_clock::now());
+                               });
+            return;
         }
+        deliverReceived(comId, data, len, baseRule, rxTime);
+    }
+
+    void PdEngine::deliverReceived(uint32_t comId, const uint8_t* data, std::size_t len, const Rule* baseRule,
+                                   std::chrono::steady_clock::time_point rxTime)
+    {
         const uint32_t targetComId = (baseRule && baseRule->corruptComId) ? (comId ^ 0x1u) : comId;
 
-        for (auto& pdPtr : m_ctx.pdTelegrams)
+        auto subs = m_ctx.pdSubscribersByComId.find(targetComId);
+        if (subs == m_ctx.pdSubscribersByComId.end())
+            return;
+
+        std::vector<std::pair<PdTelegramRuntime*, std::chrono::steady_clock::time_point>> armTimeouts;
+        std::vector<std::pair<PdTelegramRuntime*, std::chrono::steady_clock::time_point>> armFlushes;
+        for (auto* pdPtr : subs->second)
         {
             auto& pd = *pdPtr;
-            if (!pd.cfg || pd.cfg->comId != targetComId || pd.direction != Direction::SUBSCRIBE)
+            if (!pd.cfg)
                 continue;
 
             std::lock_guard<std::mutex> lk(pd.mtx);
@@ -223,7 +547,7 @@ namespace engine::pd
             if (!ds)
                 continue;
 
-            auto rule = findRule(m_ctx, pd.cfg->comId, pd.cfg->dataSetId);
+            const Rule* rule = cachedRule(m_ctx, pd);
             if (!rule)
                 rule = baseRule;
             if (rule && rule->seqDelta != 0)
@@ -241,7 +565,7 @@ namespace engine::pd
                 payloadPtr        = mutatedPayload.data();
             }
 
-            auto now       = std::chrono::steady_clock::now();
+            auto now       = rxTime;
             auto timeoutUs = pd.cfg->pdParam ? pd.cfg->pdParam->timeoutUs : pd.pdComCfg->timeoutUs;
             auto cycleUs   = pd.cfg->pdParam ? pd.cfg->pdParam->cycleUs : 0u;
             if (pd.stats.lastRxTime.time_since_epoch().count() != 0)
@@ -252,6 +576,7 @@ namespace engine::pd
                 {
                     auto jitter                = static_cast<double>(delta.count()) - static_cast<double>(cycleUs);
                     pd.stats.lastCycleJitterUs = std::abs(jitter);
+                    pd.jitterHist.record(static_cast<uint64_t>(std::abs(jitter)));
                 }
                 if (timeoutUs > 0 && static_cast<uint64_t>(delta.count()) > timeoutUs)
                 {
@@ -261,11 +586,7 @@ namespace engine::pd
                         pd.cfg->pdParam->validityBehavior == config::PdComParameter::ValidityBehavior::ZERO)
                     {
                         std::lock_guard<std::mutex> dsLock(ds->mtx);
-                        for (auto& cell : ds->values)
-                        {
-                            cell.defined = false;
-                            std::fill(cell.raw.begin(), cell.raw.end(), 0);
-                        }
+                        data::zeroAllElements(*ds);
                     }
                 }
             }
@@ -276,175 +597,784 @@ namespace engine::pd
             pd.stats.lastRxWall = std::chrono::system_clock::now();
             pd.stats.timedOut   = false;
 
-            std::lock_guard<std::mutex> dsLock(ds->mtx);
-            if (!ds->locked)
+            // An armed deadline re-arms itself from lastRxTime when it fires, so only
+            // idle subscribers need to touch the shard here.
+            if (pd.cfg->pdParam && pd.cfg->pdParam->timeoutUs > 0 && !pd.timeoutArmed)
             {
-                const bool shouldMarshall = pd.cfg->pdParam ? pd.cfg->pdParam->marshall : pd.pdComCfg->marshall;
-                if (shouldMarshall)
-                {
-                    unmarshalDataToDataSet(*ds, m_ctx, payloadPtr, len);
-                }
-                else if (!ds->values.empty())
-                {
-                    auto& cell = ds->values.front();
-                    cell.raw.assign(payloadPtr, payloadPtr + len);
-                    cell.defined = true;
-                }
+                pd.timeoutArmed = true;
+                armTimeouts.emplace_back(&pd, now + std::chrono::microseconds(pd.cfg->pdParam->timeoutUs));
+            }
+
+            const auto decodeInterval = std::chrono::microseconds(m_decodeIntervalUs.load(std::memory_order_relaxed));
+            if (decodeInterval.count() == 0)
+            {
+                decodeLocked(pd, payloadPtr, len);
+                continue;
+            }
+
+            // Keep only the newest frame; it is decoded at the configured rate or when a reader asks.
+            if (pd.mailboxPending)
+                pd.stats.coalescedFrames++;
+            pd.mailbox.assign(payloadPtr, payloadPtr + (payloadPtr ? len : 0));
+            pd.mailboxPending = true;
+            if (now - pd.lastDecode >= decodeInterval)
+            {
+                flushMailboxLocked(pd, now);
+            }
+            else if (!pd.mailboxArmed)
+            {
+                // Decoded by the shard once the interval is up, even if no further frame arrives.
+                pd.mailboxArmed = true;
+                armFlushes.emplace_back(&pd, pd.lastDecode + decodeInterval);
             }
         }
+
+        for (auto& [pd, due] : armFlushes)
+            armMailboxFlush(*pd, due);
+
+        for (auto& [pd, deadline] : armTimeouts)
+        {
+            if (pd->shard >= m_shards.size())
+                continue;
+            auto& shard = *m_shards[pd->shard];
+            {
+                std::lock_guard<std::mutex> lk(shard.mtx);
+                shard.timeouts.arm(*pd, deadline);
+            }
+            wake(shard);
+        }
     }
 
     void PdEngine::processPublishersOnce(std::chrono::steady_clock::time_point now)
-{
-    using namespace std::chrono;
-    using trdp_sim::util::marshalDataSet;
-
-    trdp_sim::SimulationControls::StressMode stressSnapshot{};
     {
-        std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
-        stressSnapshot = m_ctx.simulation.stress;
+        for (auto& shard : m_shards)
+            processShardOnce(*shard, now);
     }
-    const bool  stressActive = stressSnapshot.enabled;
-    std::size_t pdBudget     = stressActive
-                                  ? std::min<std::size_t>(stressSnapshot.pdBurstTelegrams,
-                                                          trdp_sim::SimulationControls::StressMode::kMaxBurstTelegrams)
-                                  : 0;
-    const auto minCycle = microseconds(trdp_sim::SimulationControls::StressMode::kMinCycleUs);
 
-    struct Candidate
+    void PdEngine::processShardOnce(Shard& shard, std::chrono::steady_clock::time_point now)
     {
-        PdTelegramRuntime*                       pd{nullptr};
-        microseconds                             cycle{};
-        std::chrono::steady_clock::time_point    nextDue{};
-    };
+        using namespace std::chrono;
 
-    std::vector<Candidate> due;
-    for (auto& pdPtr : m_ctx.pdTelegrams)
-    {
-        auto&                       pd = *pdPtr;
-        std::lock_guard<std::mutex> lk(pd.mtx);
-        if (!pd.enabled || !pd.cfg || !pd.cfg->pdParam || pd.direction != Direction::PUBLISH)
-            continue;
+        const auto passStart = steady_clock::now();
+
+        expireSubscribers(shard, now);
+        flushDueMailboxes(shard, now);
 
-        auto cycle = microseconds(pd.cfg->pdParam->cycleUs);
-        if (stressActive && stressSnapshot.pdCycleOverrideUs > 0)
+        trdp_sim::SimulationControls::StressMode stressSnapshot{};
         {
-            auto overrideCycle = microseconds(
-                std::max(stressSnapshot.pdCycleOverrideUs,
-                         static_cast<uint32_t>(trdp_sim::SimulationControls::StressMode::kMinCycleUs)));
-            if (overrideCycle < cycle || pd.cfg->pdParam->cycleUs == 0)
-                cycle = overrideCycle;
+            std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
+            stressSnapshot = m_ctx.simulation.stress;
         }
-        if (cycle < minCycle)
-            cycle = minCycle;
-        if (pd.stats.lastTxTime.time_since_epoch().count() == 0)
-            pd.stats.lastTxTime = now - cycle;
+        const bool     stressActive    = stressSnapshot.enabled;
+        const uint32_t cycleOverrideUs = stressActive ? stressSnapshot.pdCycleOverrideUs : 0;
+        std::size_t    pdBudget        = stressActive
+                                             ? std::min<std::size_t>(stressSnapshot.pdBurstTelegrams,
+                                                                     trdp_sim::SimulationControls::StressMode::kMaxBurstTelegrams)
+                                             : 0;
+        // The stress burst is a per-tick total; spread it over the shards, the first ones taking
+        // the remainder.
+        pdBudget = pdBudget / m_shards.size() + (shard.index < pdBudget % m_shards.size() ? 1 : 0);
+        const auto rates = stressActive ? stressSnapshot.pdRates : nullptr;
+
+        const auto timing = timingConfig();
 
-        const auto nextDue = pd.stats.lastTxTime + cycle;
-        bool       isDue   = pd.sendNow || now >= nextDue;
-        if (!isDue && stressActive && pdBudget > 0)
+        // Where a serviced slot leaves the publisher: its token bucket when paced,
+        // otherwise the cycle schedule.
+        const auto nextSlot = [&](PdTelegramRuntime& pd)
         {
-            isDue = true;
-            --pdBudget;
-            pd.stats.stressBursts++;
-        }
+            if (!pd.pacing.active())
+                return advanceCycle(pd, now, effectiveCycle(pd, cycleOverrideUs), timing);
+            pd.stats.pacedSends++;
+            pd.nextDue = pd.pacing.nextRelease(now);
+            return pd.nextDue;
+        };
 
-        if (isDue)
-            due.push_back(Candidate{&pd, cycle, nextDue});
-    }
+        struct Candidate
+        {
+            PdScheduler::Entry entry{};
+            bool               burst{false};
+        };
 
-    std::sort(due.begin(), due.end(), [](const Candidate& a, const Candidate& b) {
-        if (a.nextDue == b.nextDue)
-            return (a.pd && b.pd && a.pd->cfg && b.pd->cfg) ? a.pd->cfg->comId < b.pd->cfg->comId : a.nextDue < b.nextDue;
-        return a.nextDue < b.nextDue;
-    });
+        // Only telegrams whose deadline has passed leave the heap; stress bursts
+        // pull the next-soonest telegrams forward.
+        std::vector<Candidate> due;
+        {
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            if (cycleOverrideUs != shard.appliedCycleOverrideUs || rates != shard.appliedRates)
+                rearmShardLocked(shard, now, cycleOverrideUs, rates);
 
-    for (auto& item : due)
-    {
-        auto&                       pd = *item.pd;
-        std::lock_guard<std::mutex> lk(pd.mtx);
-        auto*                       ds = pd.dataset;
-        if (!ds)
-            continue;
+            PdScheduler::Entry entry;
+            while (shard.scheduler.popDue(now, entry))
+                due.push_back(Candidate{entry, false});
+            while (pdBudget > 0 && shard.scheduler.popNext(entry))
+            {
+                due.push_back(Candidate{entry, true});
+                --pdBudget;
+            }
+        }
+
+        std::vector<std::pair<PdTelegramRuntime*, steady_clock::time_point>> rearm;
+        rearm.reserve(due.size());
+        uint64_t sends{0};
+        uint64_t sendErrors{0};
+
+        // Telegrams ready to go are handed to the adapter in one batch; each stays locked
+        // until its outcome has been accounted for.
+        std::vector<trdp_sim::trdp::PdSendItem>  batch;
+        std::vector<std::size_t>                 batchRearm;
+        std::vector<std::unique_lock<std::mutex>> held;
+        batch.reserve(due.size());
+        batchRearm.reserve(due.size());
+        held.reserve(due.size());
 
-        const auto rule = pd.cfg ? findRule(m_ctx, pd.cfg->comId, pd.cfg->dataSetId) : std::nullopt;
-        if (rule)
+        for (auto& item : due)
         {
-            if (shouldDrop(*rule))
+            auto&                        pd = *item.entry.pd;
+            std::unique_lock<std::mutex> lk(pd.mtx);
+            auto*                        ds = pd.dataset;
+            // Disabled or unusable telegrams stay parked until enableTelegram() re-arms them.
+            if (!pd.enabled || !pd.cfg || !pd.cfg->pdParam || pd.direction != Direction::PUBLISH || !ds)
                 continue;
-            applyDelay(*rule);
-            if (rule->corruptComId && m_ctx.diagManager)
+            if (item.burst)
+                pd.stats.stressBursts++;
+
+            // Paced publishers only go out with a token; early pops (bursts, triggers) wait for it.
+            if (pd.pacing.active() && !pd.pacing.tryConsume(now))
+            {
+                rearm.emplace_back(&pd, pd.pacing.nextRelease(now));
+                continue;
+            }
+
+            // Failed or dropped sends are retried on the next scheduler tick, or with the next token.
+            rearm.emplace_back(&pd, pd.pacing.active() ? pd.pacing.nextRelease(now) : now + kRetryInterval);
+
+            const Rule* rule = cachedRule(m_ctx, pd);
+            if (rule)
+            {
+                if (shouldDrop(*rule))
+                    continue;
+                if (rule->corruptComId && m_ctx.diagManager)
+                {
+                    m_ctx.diagManager->log(diag::Severity::WARN, "PD", "Injecting COM ID corruption for PD telegram");
+                }
+            }
+
+            const bool  shouldMarshall = pd.cfg->pdParam ? pd.cfg->pdParam->marshall : pd.pdComCfg->marshall;
+            const auto* payload        = &cachedPayloadFor(pd, *ds, shouldMarshall, m_ctx);
+
+            // Corruption is applied to the scratch buffer so the cached payload stays clean.
+            if (rule && (rule->corruptDataSetId || rule->corruptComId))
+            {
+                auto& corrupted = pd.txScratch;
+                corrupted.clear();
+                if (rule->corruptComId)
+                    corrupted.push_back(0xCD);
+                corrupted.insert(corrupted.end(), payload->begin(), payload->end());
+                if (rule->corruptDataSetId && payload->size() > 0)
+                {
+                    auto& first = corrupted[rule->corruptComId ? 1 : 0];
+                    first       = static_cast<uint8_t>(first ^ 0xFF);
+                }
+                payload = &corrupted;
+            }
+
+            if (rule && rule->seqDelta != 0)
+            {
+                auto next = static_cast<int64_t>(pd.stats.lastSeqNumber) + rule->seqDelta;
+                pd.stats.lastSeqNumber = next < 0 ? 0 : static_cast<uint64_t>(next);
+            }
+
+            if (rule && rule->delayMs > 0)
             {
-                m_ctx.diagManager->log(diag::Severity::WARN, "PD", "Injecting COM ID corruption for PD telegram");
+                // The slot counts as serviced; the payload goes out when the release queue fires.
+                m_release.schedule(releaseTime(*rule), [this, &pd, bytes = *payload]() { releaseDelayedSend(pd, bytes); });
+                pd.sendNow          = false;
+                rearm.back().second = nextSlot(pd);
+                continue;
             }
+
+            batch.push_back(trdp_sim::trdp::PdSendItem{&pd, payload->data(), payload->size()});
+            batchRearm.push_back(rearm.size() - 1);
+            held.push_back(std::move(lk));
         }
 
-        std::lock_guard<std::mutex> dsLock(ds->mtx);
-        const bool                  shouldMarshall = pd.cfg->pdParam ? pd.cfg->pdParam->marshall : pd.pdComCfg->marshall;
-        auto payload = shouldMarshall ? marshalDataSet(*ds, m_ctx)
-                                      : std::vector<uint8_t>(ds->values.empty() ? 0 : ds->values.front().raw.size());
-        if (!shouldMarshall && !ds->values.empty())
+        if (!batch.empty())
+            m_adapter.sendPdBatch(batch.data(), batch.size());
+
+        const auto txWall = std::chrono::system_clock::now();
+        for (std::size_t i = 0; i < batch.size(); ++i)
         {
-            payload = ds->values.front().raw;
+            auto&     pd = *batch[i].pd;
+            const int rc = batch[i].result;
+            if (rc == 0 || rc == trdp_sim::trdp::kPdSoftDropCode)
+            {
+                if (rc == 0)
+                    pd.stats.txCount++;
+                pd.stats.lastSeqNumber++;
+                pd.stats.lastTxTime         = now;
+                pd.stats.lastTxWall         = txWall;
+                pd.sendNow                  = false;
+                rearm[batchRearm[i]].second = nextSlot(pd);
+                ++sends;
+            }
+            else
+            {
+                ++sendErrors;
+                pd.stats.txErrors++;
+                std::cerr << "Failed to send PD COM ID " << (pd.cfg ? pd.cfg->comId : 0) << " (rc=" << rc << ")" << std::endl;
+            }
         }
+        held.clear();
+
+        if (due.empty())
+            return;
 
-        if (rule && rule->corruptDataSetId && !payload.empty())
-            payload[0] = static_cast<uint8_t>(payload[0] ^ 0xFF);
-        if (rule && rule->corruptComId)
-            payload.insert(payload.begin(), 0xCD);
+        const auto passUs = duration<double, std::micro>(steady_clock::now() - passStart).count();
 
-        if (rule && rule->seqDelta != 0)
+        std::lock_guard<std::mutex> lk(shard.mtx);
+        shard.stats.passes++;
+        shard.stats.sends += sends;
+        shard.stats.sendErrors += sendErrors;
+        shard.stats.maxPassUs = std::max(shard.stats.maxPassUs, passUs);
+        shard.stats.maxSendsPerPass = std::max(shard.stats.maxSendsPerPass, sends);
+        for (auto& [pd, at] : rearm)
         {
-            auto next = static_cast<int64_t>(pd.stats.lastSeqNumber) + rule->seqDelta;
-            pd.stats.lastSeqNumber = next < 0 ? 0 : static_cast<uint64_t>(next);
+            // A concurrent triggerSendNow()/enableTelegram() may already have re-armed it.
+            if (!shard.scheduler.isArmed(*pd))
+                shard.scheduler.arm(*pd, at);
         }
+    }
 
+    void PdEngine::releaseDelayedSend(PdTelegramRuntime& pd, const std::vector<uint8_t>& payload)
+    {
+        std::lock_guard<std::mutex> lk(pd.mtx);
+        if (!pd.enabled)
+            return;
         int rc = m_adapter.sendPdData(pd, payload);
         if (rc == 0 || rc == trdp_sim::trdp::kPdSoftDropCode)
         {
             if (rc == 0)
                 pd.stats.txCount++;
             pd.stats.lastSeqNumber++;
-            pd.stats.lastTxTime = now;
+            pd.stats.lastTxTime = std::chrono::steady_clock::now();
             pd.stats.lastTxWall = std::chrono::system_clock::now();
-            pd.sendNow          = false;
         }
         else
         {
-            std::cerr << "Failed to send PD COM ID " << (pd.cfg ? pd.cfg->comId : 0) << " (rc=" << rc << ")" << std::endl;
+            std::cerr << "Failed to send delayed PD COM ID " << (pd.cfg ? pd.cfg->comId : 0) << " (rc=" << rc << ")"
+                      << std::endl;
         }
     }
-}
 
-void PdEngine::runPublisherLoop()
-{
-    using namespace std::chrono_literals;
+    void PdEngine::rearmShardLocked(Shard& shard, std::chrono::steady_clock::time_point now, uint32_t cycleOverrideUs,
+                                    const std::shared_ptr<const trdp_sim::SimulationControls::PdRateTargets>& rates)
+    {
+        for (auto* pdPtr : shard.publishers)
+        {
+            auto& pd = *pdPtr;
+            if (!pd.cfg || !pd.cfg->pdParam)
+                continue;
+            std::lock_guard<std::mutex> lk(pd.mtx);
 
-    while (m_running.load())
+            // Interface targets are split evenly and phase-shifted across its publishers.
+            double target{0.0};
+            double phase{0.0};
+            if (rates)
+            {
+                auto comIt = rates->perComId.find(pd.cfg->comId);
+                if (comIt != rates->perComId.end())
+                {
+                    target = comIt->second;
+                }
+                else if (pd.ifaceCfg)
+                {
+                    auto ifIt = rates->perInterface.find(pd.ifaceCfg->name);
+                    if (ifIt != rates->perInterface.end())
+                    {
+                        target = ifIt->second / static_cast<double>(pd.ifacePublisherCount);
+                        phase  = static_cast<double>(pd.ifacePublisherIndex) / static_cast<double>(pd.ifacePublisherCount);
+                    }
+                }
+            }
+
+            auto due = now;
+            if (target > 0.0)
+            {
+                pd.pacing.configure(target, now, phase);
+                pd.pacingStart       = now;
+                pd.stats.pacedSends  = 0;
+                due                  = pd.pacing.nextRelease(now);
+            }
+            else
+            {
+                pd.pacing.reset();
+                if (pd.stats.lastTxTime.time_since_epoch().count() != 0 && !pd.sendNow)
+                    due = std::max(now, pd.stats.lastTxTime + effectiveCycle(pd, cycleOverrideUs));
+            }
+            pd.nextDue = due;
+            shard.scheduler.arm(pd, due);
+        }
+        shard.appliedCycleOverrideUs = cycleOverrideUs;
+        shard.appliedRates           = rates;
+    }
+
+    void PdEngine::expireSubscribers(Shard& shard, std::chrono::steady_clock::time_point now)
+    {
+        std::vector<PdTelegramRuntime*> fired;
+        {
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            PdScheduler::Entry          entry;
+            while (shard.timeouts.popDue(now, entry))
+                fired.push_back(entry.pd);
+        }
+        if (fired.empty())
+            return;
+
+        std::vector<std::pair<PdTelegramRuntime*, std::chrono::steady_clock::time_point>> rearm;
+        for (auto* pd : fired)
+        {
+            std::lock_guard<std::mutex> lk(pd->mtx);
+            const auto deadline = pd->stats.lastRxTime + std::chrono::microseconds(pd->cfg->pdParam->timeoutUs);
+            if (now < deadline)
+            {
+                // Telegrams arrived since the deadline was armed; move it along.
+                rearm.emplace_back(pd, deadline);
+                continue;
+            }
+            if (!pd->stats.timedOut)
+            {
+                pd->stats.timeoutCount++;
+                pd->stats.timedOut = true;
+            }
+            pd->timeoutArmed = false;
+        }
+
+        if (rearm.empty())
+            return;
+        std::lock_guard<std::mutex> lk(shard.mtx);
+        for (auto& [pd, deadline] : rearm)
+            shard.timeouts.arm(*pd, deadline);
+    }
+
+    void PdEngine::armMailboxFlush(PdTelegramRuntime& pd, std::chrono::steady_clock::time_point due)
+    {
+        if (pd.shard >= m_shards.size())
+            return;
+        auto& shard = *m_shards[pd.shard];
+        {
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            shard.mailboxFlushes.emplace_back(due, &pd);
+            std::push_heap(shard.mailboxFlushes.begin(), shard.mailboxFlushes.end(), std::greater<>{});
+        }
+        wake(shard);
+    }
+
+    void PdEngine::flushDueMailboxes(Shard& shard, std::chrono::steady_clock::time_point now)
+    {
+        std::vector<PdTelegramRuntime*> due;
+        {
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            auto& heap = shard.mailboxFlushes;
+            while (!heap.empty() && heap.front().first <= now)
+            {
+                due.push_back(heap.front().second);
+                std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+                heap.pop_back();
+            }
+        }
+
+        const auto decodeInterval = std::chrono::microseconds(m_decodeIntervalUs.load(std::memory_order_relaxed));
+        for (auto* pd : due)
+        {
+            std::chrono::steady_clock::time_point next{};
+            {
+                std::lock_guard<std::mutex> lk(pd->mtx);
+                pd->mailboxArmed = false;
+                if (!pd->mailboxPending)
+                    continue; // a reader already decoded it
+                if (decodeInterval.count() == 0 || now - pd->lastDecode >= decodeInterval)
+                {
+                    flushMailboxLocked(*pd, now);
+                    continue;
+                }
+                pd->mailboxArmed = true;
+                next             = pd->lastDecode + decodeInterval;
+            }
+            armMailboxFlush(*pd, next);
+        }
+    }
+
+    void PdEngine::setTimingConfig(const PdTimingConfig& cfg)
     {
+        {
+            std::lock_guard<std::mutex> lk(m_cfgMtx);
+            m_timing = cfg;
+        }
+        wakeAll();
+    }
+
+    PdTimingConfig PdEngine::timingConfig() const
+    {
+        std::lock_guard<std::mutex> lk(m_cfgMtx);
+        return m_timing;
+    }
+
+    void PdEngine::setRealtimeConfig(const PdRealtimeConfig& cfg)
+    {
+        std::lock_guard<std::mutex> lk(m_cfgMtx);
+        m_realtime = cfg;
+    }
+
+    PdRealtimeConfig PdEngine::realtimeConfig() const
+    {
+        std::lock_guard<std::mutex> lk(m_cfgMtx);
+        return m_realtime;
+    }
+
+    void PdEngine::setShardingConfig(const PdShardingConfig& cfg)
+    {
+        std::lock_guard<std::mutex> lk(m_cfgMtx);
+        m_sharding = cfg;
+    }
+
+    PdShardingConfig PdEngine::shardingConfig() const
+    {
+        std::lock_guard<std::mutex> lk(m_cfgMtx);
+        return m_sharding;
+    }
+
+    void PdEngine::setRxConfig(const PdRxConfig& cfg)
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_cfgMtx);
+            m_rx = cfg;
+        }
+        const int64_t intervalUs = cfg.decodeRateHz > 0.0 ? static_cast<int64_t>(1e6 / cfg.decodeRateHz) : 0;
+        m_decodeIntervalUs.store(intervalUs, std::memory_order_relaxed);
+    }
+
+    void PdEngine::decodeLocked(PdTelegramRuntime& pd, const uint8_t* data, std::size_t len)
+    {
+        auto* ds = pd.dataset;
+        if (!ds)
+            return;
+        std::lock_guard<std::mutex> dsLock(ds->mtx);
+        if (ds->locked)
+            return;
+        const bool shouldMarshall = pd.cfg->pdParam ? pd.cfg->pdParam->marshall : pd.pdComCfg->marshall;
+        if (shouldMarshall)
+        {
+            unmarshalDataToDataSet(*ds, m_ctx, data, len);
+        }
+        else if (data::elementCount(*ds) > 0)
+        {
+            data::setElementBytes(*ds, 0, data, len);
+        }
+        pd.stats.decodes++;
+    }
+
+    void PdEngine::flushMailboxLocked(PdTelegramRuntime& pd, std::chrono::steady_clock::time_point now)
+    {
+        if (!pd.mailboxPending)
+            return;
+        decodeLocked(pd, pd.mailbox.data(), pd.mailbox.size());
+        pd.mailboxPending = false;
+        pd.lastDecode     = now;
+    }
+
+    void PdEngine::syncDataSet(uint32_t dataSetId)
+    {
+        auto it = m_subscribersByDataSet.find(dataSetId);
+        if (it == m_subscribersByDataSet.end())
+            return;
         const auto now = std::chrono::steady_clock::now();
-        processPublishersOnce(now);
+        for (auto* pd : it->second)
+        {
+            std::lock_guard<std::mutex> lk(pd->mtx);
+            flushMailboxLocked(*pd, now);
+        }
+    }
 
-        for (auto& pdPtr : m_ctx.pdTelegrams)
+    PdRxConfig PdEngine::rxConfig() const
+    {
+        std::lock_guard<std::mutex> lk(m_cfgMtx);
+        return m_rx;
+    }
+
+    std::vector<PdRxStats> PdEngine::rxStats() const
+    {
+        std::vector<PdRxStats> out;
+        for (std::size_t i = 0; i < m_rxRings.size(); ++i)
+        {
+            PdRxStats stats{};
+            stats.channel = i;
+            if (i < m_ctx.deviceConfig.interfaces.size())
+                stats.interfaceName = m_ctx.deviceConfig.interfaces[i].name;
+            stats.ring = m_rxRings[i]->stats();
+            out.push_back(std::move(stats));
+        }
+        return out;
+    }
+
+    void PdEngine::startRxWorker()
+    {
+        if (m_rxRings.empty() || m_rxRunning.exchange(true))
+            return;
+        m_rxThread = std::thread(&PdEngine::runRxLoop, this);
+    }
+
+    void PdEngine::stopRxWorker()
+    {
+        if (!m_rxRunning.exchange(false))
+            return;
+        {
+            std::lock_guard<std::mutex> lk(m_rxMtx);
+            m_rxCv.notify_one();
+        }
+        if (m_rxThread.joinable())
+            m_rxThread.join();
+        // The worker is gone, so this thread may act as the consumer.
+        while (drainRx() > 0)
+        {
+        }
+    }
+
+    void PdEngine::runRxLoop()
+    {
+        while (m_rxRunning.load())
+        {
+            if (drainRx() > 0)
+                continue;
+
+            std::unique_lock<std::mutex> lk(m_rxMtx);
+            m_rxIdle.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const bool pending = std::any_of(m_rxRings.begin(), m_rxRings.end(),
+                                             [](const auto& ring) { return !ring->empty(); });
+            if (!pending && m_rxRunning.load())
+                m_rxCv.wait_for(lk, kRxIdleWait);
+            m_rxIdle.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t PdEngine::drainRx()
+    {
+        std::size_t drained = 0;
+        for (auto& ring : m_rxRings)
+        {
+            drained += ring->drain([this](const trdp_sim::util::SpscFrameRing::Frame& frame)
+                                   { processReceived(frame.comId, frame.data, frame.len, frame.rxTime); },
+                                   kRxDrainBatch);
+        }
+        return drained;
+    }
+
+    std::vector<PdShardStats> PdEngine::shardStats() const
+    {
+        std::vector<PdShardStats> out;
+        out.reserve(m_shards.size());
+        for (const auto& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lk(shard->mtx);
+            out.push_back(shard->stats);
+        }
+        return out;
+    }
+
+    std::vector<PdRateStats> PdEngine::rateStats() const
+    {
+        std::vector<PdRateStats> out;
+        const auto               now = std::chrono::steady_clock::now();
+        for (const auto& pdPtr : m_ctx.pdTelegrams)
         {
             auto&                       pd = *pdPtr;
             std::lock_guard<std::mutex> lk(pd.mtx);
-            if (pd.direction == Direction::SUBSCRIBE && pd.cfg && pd.cfg->pdParam)
+            if (!pd.pacing.active() || !pd.cfg)
+                continue;
+            PdRateStats s;
+            s.comId           = pd.cfg->comId;
+            s.interfaceName   = pd.ifaceCfg ? pd.ifaceCfg->name : std::string{};
+            s.targetPerSecond = pd.pacing.rate();
+            const auto elapsed = std::chrono::duration<double>(now - pd.pacingStart).count();
+            if (elapsed > 0.0)
+                s.achievedPerSecond = static_cast<double>(pd.stats.pacedSends) / elapsed;
+            out.push_back(std::move(s));
+        }
+        return out;
+    }
+
+    PdWakeupStats PdEngine::wakeupStats() const
+    {
+        PdWakeupStats total{};
+        bool          allRealtime = !m_shards.empty();
+        for (const auto& stats : shardStats())
+        {
+            const auto& w = stats.wakeup;
+            allRealtime   = allRealtime && w.realtime;
+            if (w.samples == 0)
+                continue;
+            total.meanUs = (total.meanUs * static_cast<double>(total.samples) + w.meanUs * static_cast<double>(w.samples)) /
+                           static_cast<double>(total.samples + w.samples);
+            total.samples += w.samples;
+            total.lastUs = w.lastUs;
+            total.maxUs  = std::max(total.maxUs, w.maxUs);
+        }
+        total.realtime = allRealtime;
+        return total;
+    }
+
+    bool PdEngine::applyRealtimeSettings(const Shard& shard)
+    {
+        PdRealtimeConfig cfg = realtimeConfig();
+
+        uint32_t priority{0};
+        for (const auto& iface : m_ctx.deviceConfig.interfaces)
+            priority = std::max<uint32_t>(priority, iface.trdpProcess.priority);
+
+        const auto warn = [this, &shard](const std::string& msg)
+        {
+            std::cerr << "PD real-time (shard " << shard.index << "): " << msg << std::endl;
+            if (m_ctx.diagManager)
+                m_ctx.diagManager->log(diag::Severity::WARN, "PD", "Real-time setup: " + msg);
+        };
+
+        if (cfg.lockMemory && shard.index == 0 && mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+            warn(std::string("mlockall failed: ") + std::strerror(errno));
+
+        if (cfg.cpu)
+        {
+            // Shards take consecutive cores starting at the configured one.
+            const int  cpu    = *cfg.cpu + static_cast<int>(shard.index);
+            const long online = sysconf(_SC_NPROCESSORS_ONLN);
+            if (cpu < 0 || cpu >= CPU_SETSIZE || (online > 0 && cpu >= online))
+            {
+                warn("CPU " + std::to_string(cpu) + " is out of range, not pinning");
+            }
+            else
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+                if (rc != 0)
+                    warn("pinning to CPU " + std::to_string(cpu) + " failed: " + std::strerror(rc));
+            }
+        }
+
+        sched_param param{};
+        param.sched_priority = std::clamp(static_cast<int>(priority), sched_get_priority_min(SCHED_FIFO),
+                                          sched_get_priority_max(SCHED_FIFO));
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc != 0)
+        {
+            warn("SCHED_FIFO priority " + std::to_string(param.sched_priority) + " failed: " + std::strerror(rc));
+            return false;
+        }
+        if (m_ctx.diagManager)
+        {
+            m_ctx.diagManager->log(diag::Severity::INFO, "PD",
+                                   "Publisher shard " + std::to_string(shard.index) + " running SCHED_FIFO priority " +
+                                       std::to_string(param.sched_priority) + ", tick " +
+                                       std::to_string(m_realtimeTick.count()) + " us");
+        }
+        return true;
+    }
+
+    void PdEngine::reschedule()
+    {
+        wakeAll();
+    }
+
+    void PdEngine::wake(Shard& shard)
+    {
+        {
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            shard.kick = true;
+        }
+        shard.cv.notify_one();
+    }
+
+    void PdEngine::wakeAll()
+    {
+        for (auto& shard : m_shards)
+            wake(*shard);
+    }
+
+    void PdEngine::runShardLoop(Shard& shard)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const auto recordWakeup = [&shard](Clock::time_point target, Clock::time_point actual)
+        {
+            auto&      w      = shard.stats.wakeup;
+            const auto lateUs = actual > target ? std::chrono::duration<double, std::micro>(actual - target).count() : 0.0;
+            w.samples++;
+            w.lastUs = lateUs;
+            w.maxUs  = std::max(w.maxUs, lateUs);
+            w.meanUs += (lateUs - w.meanUs) / static_cast<double>(w.samples);
+        };
+
+        const bool realtimeMode = realtimeConfig().enabled;
+        if (realtimeMode)
+        {
+            const bool fifo = applyRealtimeSettings(shard);
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            shard.stats.wakeup.realtime = fifo;
+        }
+
+        while (m_running.load())
+        {
+            const auto now = Clock::now();
+            processShardOnce(shard, now);
+
+            bool burstTicks{false};
+            {
+                std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
+                burstTicks = m_ctx.simulation.stress.enabled && m_ctx.simulation.stress.pdBurstTelegrams > 0;
+            }
+
+            // Sleep until the earliest publisher or subscriber-timeout deadline; stress
+            // bursts still run on the fixed 1 ms tick.
+            std::unique_lock<std::mutex> lk(shard.mtx);
+            auto                         wakeAt = shard.scheduler.nextDue();
+            const auto                   bound  = [&wakeAt](Clock::time_point tp)
+            {
+                if (!wakeAt || tp < *wakeAt)
+                    wakeAt = tp;
+            };
+            if (auto timeoutDue = shard.timeouts.nextDue())
+                bound(*timeoutDue);
+            if (!shard.mailboxFlushes.empty())
+                bound(shard.mailboxFlushes.front().first);
+            if (burstTicks)
+                bound(now + kRetryInterval);
+
+            if (realtimeMode)
             {
-                auto timeoutUs = pd.cfg->pdParam->timeoutUs;
-                if (timeoutUs > 0 && pd.stats.lastRxTime.time_since_epoch().count() != 0)
+                // Absolute sleeps cannot be interrupted by wake(), so never sleep past one
+                // TRDP process cycle; kicks are picked up on the next tick.
+                bound(now + m_realtimeTick);
+                if (shard.kick)
                 {
-                    auto delta = std::chrono::duration_cast<std::chrono::microseconds>(now - pd.stats.lastRxTime);
-                    if (!pd.stats.timedOut && static_cast<uint64_t>(delta.count()) > timeoutUs)
-                    {
-                        pd.stats.timeoutCount++;
-                        pd.stats.timedOut = true;
-                    }
+                    shard.kick = false;
+                    continue;
                 }
+                lk.unlock();
+                sleepUntil(*wakeAt);
+                const auto woke = Clock::now();
+                lk.lock();
+                recordWakeup(*wakeAt, woke);
+                shard.kick = false;
+                continue;
             }
+
+            const auto kicked = [this, &shard] { return shard.kick || !m_running.load(); };
+            if (!wakeAt)
+                shard.cv.wait(lk, kicked);
+            else if (!shard.cv.wait_until(lk, *wakeAt, kicked))
+                recordWakeup(*wakeAt, Clock::now());
+            shard.kick = false;
         }
-        std::this_thread::sleep_for(1ms);
     }
-}
 
 } // namespace engine::pd
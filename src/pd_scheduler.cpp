@@ -0,0 +1,128 @@
+#include "pd_scheduler.hpp"
+#include "pd_engine.hpp"
+
+#include <algorithm>
+
+namespace engine::pd
+{
+
+    void PdScheduler::clear()
+    {
+        // Runtimes may already be gone (configuration reload), so entries are
+        // dropped without touching them.
+        m_heap.clear();
+        m_live = 0;
+    }
+
+    void PdScheduler::arm(PdTelegramRuntime& pd, TimePoint due)
+    {
+        if (pd.schedToken == 0)
+            ++m_live;
+        pd.schedToken = m_nextToken++;
+        m_heap.push_back(Entry{due, pd.cfg ? pd.cfg->comId : 0, pd.schedToken, &pd});
+        std::push_heap(m_heap.begin(), m_heap.end(), Later{});
+
+        // Stale entries are normally discarded as they reach the top; compact if
+        // frequent re-arming has let them dominate the heap.
+        if (m_heap.size() > 64 && m_heap.size() > 4 * m_live)
+        {
+            m_heap.erase(std::remove_if(m_heap.begin(), m_heap.end(), [this](const Entry& e) { return !isLive(e); }),
+                         m_heap.end());
+            std::make_heap(m_heap.begin(), m_heap.end(), Later{});
+        }
+    }
+
+    void PdScheduler::disarm(PdTelegramRuntime& pd)
+    {
+        if (pd.schedToken == 0)
+            return;
+        pd.schedToken = 0;
+        --m_live;
+    }
+
+    bool PdScheduler::popDue(TimePoint now, Entry& out)
+    {
+        dropStale();
+        if (m_heap.empty() || m_heap.front().due > now)
+            return false;
+        return popNext(out);
+    }
+
+    bool PdScheduler::popNext(Entry& out)
+    {
+        dropStale();
+        if (m_heap.empty())
+            return false;
+        std::pop_heap(m_heap.begin(), m_heap.end(), Later{});
+        out = m_heap.back();
+        m_heap.pop_back();
+        out.pd->schedToken = 0;
+        --m_live;
+        return true;
+    }
+
+    std::optional<PdScheduler::TimePoint> PdScheduler::nextDue()
+    {
+        dropStale();
+        if (m_heap.empty())
+            return std::nullopt;
+        return m_heap.front().due;
+    }
+
+    bool PdScheduler::isArmed(const PdTelegramRuntime& pd) const
+    {
+        return pd.schedToken != 0;
+    }
+
+    bool PdScheduler::isLive(const Entry& e) const
+    {
+        return e.pd && e.token == e.pd->schedToken;
+    }
+
+    void PdScheduler::dropStale()
+    {
+        while (!m_heap.empty() && !isLive(m_heap.front()))
+        {
+            std::pop_heap(m_heap.begin(), m_heap.end(), Later{});
+            m_heap.pop_back();
+        }
+    }
+
+    void PdTokenBucket::configure(double ratePerSecond, TimePoint now, double phase)
+    {
+        m_rate   = ratePerSecond > 0.0 ? ratePerSecond : 0.0;
+        m_origin = now;
+        m_offset = m_rate > 0.0 ? std::clamp(phase, 0.0, 1.0) / m_rate : 0.0;
+    }
+
+    PdTokenBucket::TimePoint PdTokenBucket::due() const
+    {
+        // Round up so a publisher armed for this instant finds its token.
+        return m_origin + std::chrono::ceil<PdScheduler::Clock::duration>(std::chrono::duration<double>(m_offset));
+    }
+
+    bool PdTokenBucket::tryConsume(TimePoint now)
+    {
+        if (!active())
+            return true;
+        if (now < due())
+            return false;
+        // Advance from the release just spent, not from `now`, so lateness under one
+        // interval carries over as credit; a longer stall restarts the schedule at `now`
+        // rather than banking a burst. Re-anchoring on `now` keeps the offset small
+        // without dropping its fraction.
+        const double interval = 1.0 / m_rate;
+        const double late     = std::chrono::duration<double>(now - m_origin).count() - m_offset;
+        m_offset              = late < interval ? interval - late : interval;
+        m_origin              = now;
+        return true;
+    }
+
+    PdTokenBucket::TimePoint PdTokenBucket::nextRelease(TimePoint now) const
+    {
+        if (!active())
+            return now;
+        return std::max(now, due());
+    }
+
+} // namespace engine::pd
@@ -0,0 +1,53 @@
+#include "pd_send_recorder.hpp"
+
+namespace trdp_sim::trdp
+{
+
+    void PdSendRecorder::recordAttempt(uint32_t comId, uint32_t channel, bool dropped)
+    {
+        if (!enabled())
+            return;
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_ring[m_next] = PdSendLogEntry{comId, channel, dropped};
+        m_next         = (m_next + 1) % kCapacity;
+        if (m_size < kCapacity)
+            ++m_size;
+    }
+
+    void PdSendRecorder::recordPayload(const uint8_t* data, std::size_t len)
+    {
+        if (!enabled())
+            return;
+        std::lock_guard<std::mutex> lk(m_mtx);
+        if (data && len > 0)
+            m_lastPayload.assign(data, data + len);
+        else
+            m_lastPayload.clear();
+    }
+
+    void PdSendRecorder::clear()
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_next = 0;
+        m_size = 0;
+        m_lastPayload.clear();
+    }
+
+    std::vector<PdSendLogEntry> PdSendRecorder::entries() const
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        std::vector<PdSendLogEntry> out;
+        out.reserve(m_size);
+        const auto first = (m_next + kCapacity - m_size) % kCapacity;
+        for (std::size_t i = 0; i < m_size; ++i)
+            out.push_back(m_ring[(first + i) % kCapacity]);
+        return out;
+    }
+
+    std::vector<uint8_t> PdSendRecorder::lastPayload() const
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        return m_lastPayload;
+    }
+
+} // namespace trdp_sim::trdp
@@ -1,8 +1,14 @@
 #include "performance_harness.hpp"
 
+#include "engine_context.hpp"
+#include "pd_engine.hpp"
+
+#include <algorithm>
 #include <cmath>
+#include <mutex>
 #include <numeric>
 #include <sstream>
+#include <thread>
 
 namespace trdp_sim::perf
 {
@@ -43,8 +49,96 @@ namespace trdp_sim::perf
             return static_cast<double>(events.size() - 1) / total.count();
         }
 
+        using StressMode = trdp_sim::SimulationControls::StressMode;
+
+        // Stress mode ticks the publisher threads every millisecond while bursting, and
+        // a runtime is popped at most once per tick.
+        constexpr double kTicksPerSecond = 1'000'000.0 / StressMode::kMinCycleUs;
+
+        struct InterfaceProbe
+        {
+            InterfaceSaturation                        result;
+            std::vector<engine::pd::PdTelegramRuntime*> publishers;
+            uint64_t                                   txBaseline{0};
+            uint64_t                                   errorBaseline{0};
+            trdp_sim::util::LatencyHistogram::Snapshot latenessBaseline;
+        };
+
+        // Lateness of the publishers' cycle histograms merged into one snapshot.
+        trdp_sim::util::LatencyHistogram::Snapshot latenessSnapshot(const InterfaceProbe& probe)
+        {
+            trdp_sim::util::LatencyHistogram::Snapshot merged;
+            for (const auto* rt : probe.publishers)
+                merged.merge(rt->jitterHist.snapshot());
+            return merged;
+        }
+
+        // Worst lateness recorded between two snapshots, to the histogram's bucket resolution.
+        double windowMaxUs(const trdp_sim::util::LatencyHistogram::Snapshot& before,
+                           const trdp_sim::util::LatencyHistogram::Snapshot& after)
+        {
+            for (std::size_t i = after.counts.size(); i-- > 0;)
+            {
+                if (after.counts[i] > before.counts[i])
+                    return static_cast<double>(
+                        std::min(trdp_sim::util::LatencyHistogram::bucketUpperBound(i), after.maxUs));
+            }
+            return 0.0;
+        }
+
+        double offeredRate(const InterfaceProbe& probe, uint32_t overrideUs, uint32_t burst, std::size_t shards)
+        {
+            double cycleRate{0.0};
+            for (const auto* pd : probe.publishers)
+            {
+                uint32_t cycleUs = pd->cfg->pdParam->cycleUs;
+                if (overrideUs > 0 && (overrideUs < cycleUs || cycleUs == 0))
+                    cycleUs = std::max(overrideUs, StressMode::kMinCycleUs);
+                cycleUs = std::max(cycleUs, StressMode::kMinCycleUs);
+                cycleRate += 1'000'000.0 / cycleUs;
+            }
+            const auto perShard  = shards ? (burst + shards - 1) / shards : burst;
+            const auto burstRate = static_cast<double>(std::min(perShard, probe.publishers.size())) * kTicksPerSecond;
+            const auto ceiling   = static_cast<double>(probe.publishers.size()) * kTicksPerSecond;
+            return std::min(cycleRate + burstRate, ceiling);
+        }
+
+        void setStress(trdp_sim::EngineContext& ctx, engine::pd::PdEngine& pd, const StressMode& stress)
+        {
+            {
+                std::lock_guard<std::mutex> lk(ctx.simulation.mtx);
+                ctx.simulation.stress = stress;
+            }
+            pd.reschedule();
+        }
+
     } // namespace
 
+    std::string SaturationReport::toJson() const
+    {
+        std::ostringstream oss;
+        oss << "{\"platform\":\"" << (platform == Platform::VM ? "vm" : "raspberry-pi") << "\",\"interfaces\":[";
+        for (std::size_t i = 0; i < interfaces.size(); ++i)
+        {
+            const auto& iface = interfaces[i];
+            oss << (i ? "," : "") << "{\"name\":\"" << iface.name << "\",\"publishers\":" << iface.publishers
+                << ",\"maxSustainablePerSecond\":" << iface.maxSustainablePerSecond
+                << ",\"saturated\":" << (iface.saturated ? "true" : "false") << ",\"steps\":[";
+            for (std::size_t s = 0; s < iface.steps.size(); ++s)
+            {
+                const auto& step = iface.steps[s];
+                oss << (s ? "," : "") << "{\"cycleOverrideUs\":" << step.cycleOverrideUs
+                    << ",\"burstTelegrams\":" << step.burstTelegrams << ",\"offeredPerSecond\":" << step.offeredPerSecond
+                    << ",\"achievedPerSecond\":" << step.achievedPerSecond
+                    << ",\"maxJitterMicros\":" << step.maxJitterMicros << ",\"txErrors\":" << step.txErrors
+                    << ",\"sustained\":" << (step.sustained ? "true" : "false") << "}";
+            }
+            oss << "]}";
+        }
+        oss << "]}";
+        return oss.str();
+    }
+
     std::string PerformanceReport::toJson() const
     {
         std::ostringstream oss;
@@ -106,5 +200,130 @@ namespace trdp_sim::perf
                report.pdJitterMicros <= jitter && report.webUiUpdateRateHz >= thresholds.minWebUiHz;
     }
 
+    SaturationReport runPdSaturation(EngineContext& ctx, engine::pd::PdEngine& pd, const SaturationConfig& cfg)
+    {
+        SaturationReport report;
+        report.platform = cfg.platform;
+
+        std::vector<InterfaceProbe> probes;
+        uint32_t                    slowestCycleUs{0};
+        for (const auto& iface : ctx.deviceConfig.interfaces)
+        {
+            InterfaceProbe probe;
+            probe.result.name = iface.name;
+            for (auto& rt : ctx.pdTelegrams)
+            {
+                if (rt && rt->ifaceCfg == &iface && rt->cfg && rt->cfg->pdParam &&
+                    rt->direction == engine::pd::Direction::PUBLISH)
+                {
+                    probe.publishers.push_back(rt.get());
+                    slowestCycleUs = std::max(slowestCycleUs, rt->cfg->pdParam->cycleUs);
+                }
+            }
+            probe.result.publishers = probe.publishers.size();
+            if (!probe.publishers.empty())
+                probes.push_back(std::move(probe));
+        }
+        if (probes.empty())
+            return report;
+
+        StressMode previous{};
+        {
+            std::lock_guard<std::mutex> lk(ctx.simulation.mtx);
+            previous = ctx.simulation.stress;
+        }
+        const bool wasRunning = pd.isRunning();
+        if (!wasRunning)
+            pd.start();
+
+        const auto jitterLimit = cfg.platform == Platform::VM ? cfg.thresholds.jitterVmMicros
+                                                              : cfg.thresholds.jitterPiMicros;
+        const auto shards      = pd.shardStats().size();
+
+        // Halve the cycle down to the minimum, then double the burst budget.
+        StressMode stress{};
+        stress.enabled = true;
+        uint32_t overrideUs{slowestCycleUs};
+        uint32_t burst{0};
+        double   lastOffered{-1.0};
+        for (std::size_t step = 0; step < cfg.maxSteps; ++step)
+        {
+            if (overrideUs > StressMode::kMinCycleUs)
+                overrideUs = std::max(overrideUs / 2, StressMode::kMinCycleUs);
+            else
+                burst = burst == 0 ? 1 : static_cast<uint32_t>(std::min<std::size_t>(burst * 2, StressMode::kMaxBurstTelegrams));
+
+            double totalOffered{0.0};
+            for (const auto& probe : probes)
+                totalOffered += offeredRate(probe, overrideUs, burst, shards);
+            if (totalOffered <= lastOffered)
+                break; // stress mode cannot offer more
+            lastOffered = totalOffered;
+
+            stress.pdCycleOverrideUs = overrideUs;
+            stress.pdBurstTelegrams  = burst;
+            setStress(ctx, pd, stress);
+            std::this_thread::sleep_for(cfg.settleTime);
+
+            for (auto& probe : probes)
+            {
+                probe.txBaseline    = 0;
+                probe.errorBaseline = 0;
+                for (auto* rt : probe.publishers)
+                {
+                    std::lock_guard<std::mutex> lk(rt->mtx);
+                    probe.txBaseline += rt->stats.txCount;
+                    probe.errorBaseline += rt->stats.txErrors;
+                }
+                probe.latenessBaseline = latenessSnapshot(probe);
+            }
+            const auto start = std::chrono::steady_clock::now();
+            std::this_thread::sleep_for(cfg.stepDuration);
+            const auto elapsed =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            bool anyActive{false};
+            for (auto& probe : probes)
+            {
+                if (probe.result.saturated)
+                    continue;
+                SaturationStep result;
+                result.cycleOverrideUs  = overrideUs;
+                result.burstTelegrams   = burst;
+                result.offeredPerSecond = offeredRate(probe, overrideUs, burst, shards);
+                uint64_t sent{0};
+                uint64_t errors{0};
+                for (auto* rt : probe.publishers)
+                {
+                    std::lock_guard<std::mutex> lk(rt->mtx);
+                    sent += rt->stats.txCount;
+                    errors += rt->stats.txErrors;
+                }
+                result.txErrors          = errors - probe.errorBaseline;
+                result.maxJitterMicros   = windowMaxUs(probe.latenessBaseline, latenessSnapshot(probe));
+                result.achievedPerSecond = static_cast<double>(sent - probe.txBaseline) / elapsed;
+                result.sustained         = result.maxJitterMicros <= jitterLimit && result.txErrors == 0 &&
+                                   result.achievedPerSecond >= cfg.minDeliveryRatio * result.offeredPerSecond;
+                if (result.sustained)
+                    probe.result.maxSustainablePerSecond =
+                        std::max(probe.result.maxSustainablePerSecond, result.achievedPerSecond);
+                else
+                    probe.result.saturated = true;
+                probe.result.steps.push_back(result);
+                anyActive = anyActive || !probe.result.saturated;
+            }
+            if (!anyActive)
+                break;
+        }
+
+        setStress(ctx, pd, previous);
+        if (!wasRunning)
+            pd.stop();
+
+        for (auto& probe : probes)
+            report.interfaces.push_back(std::move(probe.result));
+        return report;
+    }
+
 } // namespace trdp_sim::perf
 
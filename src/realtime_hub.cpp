@@ -95,7 +95,9 @@ namespace realtime
             summary["dataSetId"] = id;
             summary["name"]      = inst->def->name;
             summary["locked"]    = inst->locked;
-            summary["size"]      = inst->values.size();
+            summary["size"]      = data::elementCount(*inst);
+            if (auto snapshot = data::publishedSnapshot(*inst))
+                summary["generation"] = snapshot->generation;
             payload["datasets"].push_back(summary);
         }
 
@@ -0,0 +1,75 @@
+#include "release_queue.hpp"
+
+#include <algorithm>
+
+namespace trdp_sim::util
+{
+
+    ReleaseQueue::~ReleaseQueue()
+    {
+        stop();
+    }
+
+    void ReleaseQueue::schedule(TimePoint releaseAt, Action action)
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        if (m_stopping)
+            return;
+        m_heap.push_back(Item{releaseAt, m_nextSeq++, std::move(action)});
+        std::push_heap(m_heap.begin(), m_heap.end(), Later{});
+        if (!m_thread.joinable())
+            m_thread = std::thread(&ReleaseQueue::run, this);
+        m_cv.notify_one();
+    }
+
+    void ReleaseQueue::stop()
+    {
+        std::thread worker;
+        {
+            std::lock_guard<std::mutex> lk(m_mtx);
+            m_stopping = true;
+            m_heap.clear();
+            worker = std::move(m_thread);
+        }
+        m_cv.notify_all();
+        if (worker.joinable())
+            worker.join();
+
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_heap.clear();
+        m_stopping = false;
+    }
+
+    std::size_t ReleaseQueue::pending() const
+    {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        return m_heap.size();
+    }
+
+    void ReleaseQueue::run()
+    {
+        std::unique_lock<std::mutex> lk(m_mtx);
+        while (!m_stopping)
+        {
+            if (m_heap.empty())
+            {
+                m_cv.wait(lk);
+                continue;
+            }
+            const auto releaseAt = m_heap.front().releaseAt;
+            if (Clock::now() < releaseAt)
+            {
+                m_cv.wait_until(lk, releaseAt);
+                continue;
+            }
+            std::pop_heap(m_heap.begin(), m_heap.end(), Later{});
+            auto action = std::move(m_heap.back().action);
+            m_heap.pop_back();
+
+            lk.unlock();
+            action();
+            lk.lock();
+        }
+    }
+
+} // namespace trdp_sim::util
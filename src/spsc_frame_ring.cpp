@@ -0,0 +1,77 @@
+#include "spsc_frame_ring.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace trdp_sim::util
+{
+
+    SpscFrameRing::SpscFrameRing(std::size_t capacity)
+    {
+        std::size_t slots = 1;
+        while (slots < capacity)
+            slots <<= 1;
+        m_slots.resize(slots);
+        m_mask = slots - 1;
+    }
+
+    bool SpscFrameRing::tryPush(uint32_t comId, const uint8_t* data, std::size_t len, TimePoint rxTime)
+    {
+        if (!fits(len))
+            return false;
+
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        const auto head = m_head.load(std::memory_order_acquire);
+        if (tail - head >= m_slots.size())
+        {
+            m_overflows.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        auto& slot  = m_slots[tail & m_mask];
+        slot.comId  = comId;
+        slot.rxTime = rxTime;
+        slot.len    = data ? len : 0;
+        if (slot.len > 0)
+            std::memcpy(slot.data, data, slot.len);
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        const auto occupancy = tail + 1 - head;
+        if (occupancy > m_highWater.load(std::memory_order_relaxed))
+            m_highWater.store(occupancy, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::size_t SpscFrameRing::drain(const std::function<void(const Frame&)>& fn, std::size_t maxFrames)
+    {
+        auto       head  = m_head.load(std::memory_order_relaxed);
+        const auto tail  = m_tail.load(std::memory_order_acquire);
+        const auto count = std::min<std::size_t>(tail - head, maxFrames);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            fn(m_slots[head & m_mask]);
+            // Release the slot only after it was consumed so the producer cannot overwrite it.
+            m_head.store(++head, std::memory_order_release);
+        }
+        return count;
+    }
+
+    bool SpscFrameRing::empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    SpscFrameRing::Stats SpscFrameRing::stats() const
+    {
+        Stats s{};
+        const auto head = m_head.load(std::memory_order_acquire);
+        const auto tail = m_tail.load(std::memory_order_acquire);
+        s.capacity      = m_slots.size();
+        s.occupancy     = tail >= head ? tail - head : 0;
+        s.highWater     = m_highWater.load(std::memory_order_relaxed);
+        s.pushed        = tail;
+        s.overflows     = m_overflows.load(std::memory_order_relaxed);
+        return s;
+    }
+
+} // namespace trdp_sim::util
@@ -0,0 +1,107 @@
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+
+namespace trdp_sim::util
+{
+
+    TimerWheel::TimerWheel(std::chrono::microseconds tick, std::size_t slots, TimePoint origin)
+        : m_tick(std::max(tick, std::chrono::microseconds(1))), m_origin(origin)
+    {
+        std::size_t count = 1;
+        while (count < slots)
+            count <<= 1;
+        m_slots.resize(count);
+        m_mask = count - 1;
+    }
+
+    uint64_t TimerWheel::tickIndexFor(TimePoint due) const
+    {
+        if (due <= m_origin)
+            return 0;
+        const auto elapsed = std::chrono::ceil<std::chrono::microseconds>(due - m_origin);
+        return static_cast<uint64_t>((elapsed.count() + m_tick.count() - 1) / m_tick.count());
+    }
+
+    bool TimerWheel::isLive(const Entry& e) const
+    {
+        auto it = m_live.find(e.id);
+        return it != m_live.end() && it->second == e.token;
+    }
+
+    void TimerWheel::schedule(uint64_t id, TimePoint due)
+    {
+        const uint64_t tickIndex = std::max(tickIndexFor(due), m_current);
+        const uint64_t token     = m_nextToken++;
+        m_live[id]               = token;
+        m_slots[tickIndex & m_mask].push_back(Entry{tickIndex, id, token});
+
+        // Re-arming keeps replaced entries in the heap; rebuild it before they dominate.
+        if (m_ticks.size() >= 2 * m_live.size() + 64)
+        {
+            m_ticks.erase(std::remove_if(m_ticks.begin(), m_ticks.end(), [this](const Entry& e) { return !isLive(e); }),
+                          m_ticks.end());
+            std::make_heap(m_ticks.begin(), m_ticks.end(), LaterTick{});
+        }
+        m_ticks.push_back(Entry{tickIndex, id, token});
+        std::push_heap(m_ticks.begin(), m_ticks.end(), LaterTick{});
+    }
+
+    void TimerWheel::cancel(uint64_t id)
+    {
+        m_live.erase(id);
+    }
+
+    void TimerWheel::clear()
+    {
+        for (auto& slot : m_slots)
+            slot.clear();
+        m_live.clear();
+        m_ticks.clear();
+    }
+
+    void TimerWheel::expire(TimePoint now, std::vector<uint64_t>& out)
+    {
+        if (now < m_origin)
+            return;
+        const auto     elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - m_origin);
+        const uint64_t nowTick = static_cast<uint64_t>(elapsed.count() / m_tick.count());
+        if (nowTick < m_current)
+            return;
+
+        // After a long stall every slot is due at most once.
+        const uint64_t last = std::min<uint64_t>(nowTick, m_current + m_slots.size() - 1);
+        for (uint64_t t = m_current; t <= last; ++t)
+        {
+            auto& slot = m_slots[t & m_mask];
+            auto  keep = slot.begin();
+            for (auto it = slot.begin(); it != slot.end(); ++it)
+            {
+                if (!isLive(*it))
+                    continue;
+                if (it->tickIndex <= nowTick)
+                {
+                    m_live.erase(it->id);
+                    out.push_back(it->id);
+                    continue;
+                }
+                *keep++ = *it; // a later round
+            }
+            slot.erase(keep, slot.end());
+        }
+        m_current = nowTick + 1;
+    }
+
+    std::optional<TimerWheel::TimePoint> TimerWheel::nextExpiry()
+    {
+        while (!m_ticks.empty() && !isLive(m_ticks.front()))
+        {
+            std::pop_heap(m_ticks.begin(), m_ticks.end(), LaterTick{});
+            m_ticks.pop_back();
+        }
+        if (m_ticks.empty())
+            return std::nullopt;
+        return m_origin + m_tick * static_cast<int64_t>(m_ticks.front().tickIndex);
+    }
+
+} // namespace trdp_sim::util
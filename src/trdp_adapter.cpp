@@ -13,6 +13,7 @@
 #include <mutex>
 #include <optional>
 #include <sys/select.h>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -91,9 +92,9 @@ namespace trdp_sim::trdp
         void pdCallback(void* refCon, TRDP_APP_SESSION_T /*session*/, const TRDP_PD_INFO_T* info, UINT8* data,
                         UINT32 dataSize)
         {
-            auto* adapter = static_cast<TrdpAdapter*>(refCon);
-            if (adapter && info)
-                adapter->handlePdCallback(info->comId, data, dataSize);
+            auto* rx = static_cast<TrdpAdapter::RxContext*>(refCon);
+            if (rx && rx->adapter && info)
+                rx->adapter->handlePdCallback(info->comId, data, dataSize, rx->channel);
         }
 
         void mdCallback(void* refCon, TRDP_APP_SESSION_T /*session*/, const TRDP_MD_INFO_T* info, UINT8* data,
@@ -145,6 +146,42 @@ namespace trdp_sim::trdp
         struct HasHostNameField<T, std::void_t<decltype(T::hostName)>> : std::true_type
         {
         };
+
+        template <typename T, typename = void>
+        struct HasCycleTimeField : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct HasCycleTimeField<T, std::void_t<decltype(T::cycleTime)>> : std::true_type
+        {
+        };
+
+        template <typename T, typename = void>
+        struct HasPriorityField : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct HasPriorityField<T, std::void_t<decltype(T::priority)>> : std::true_type
+        {
+        };
+
+        // Cycle time and priority are only honoured by stacks whose process config carries them.
+        template <typename T>
+        void applyProcessSettings(T& processCfg, const config::TrdpProcessConfig& process)
+        {
+            if constexpr (HasCycleTimeField<T>::value)
+            {
+                if (process.cycleTimeUs > 0)
+                    processCfg.cycleTime = process.cycleTimeUs;
+            }
+            if constexpr (HasPriorityField<T>::value)
+            {
+                if (process.priority > 0)
+                    processCfg.priority = process.priority;
+            }
+        }
     } // namespace
 
     TrdpAdapter::TrdpAdapter(EngineContext& ctx) : m_ctx(ctx) {}
@@ -187,27 +224,126 @@ namespace trdp_sim::trdp
             return false;
         }
 
-        err = tlc_openSession(&m_ctx.trdpSession, 0, 0, nullptr, &pdCfg, &mdCfg, &processCfg);
-        if (err != TRDP_NO_ERR)
+        // One session per interface, bound to its host IP and processed at its own TrdpProcess cycle.
+        std::vector<const config::BusInterfaceConfig*> ifaces;
+        for (const auto& iface : m_ctx.deviceConfig.interfaces)
+            ifaces.push_back(&iface);
+        if (ifaces.empty())
+            ifaces.push_back(nullptr);
+
+        std::vector<std::shared_ptr<InterfaceSession>> sessions;
+        for (const auto* iface : ifaces)
         {
-            recordError(static_cast<uint32_t>(err), &TrdpErrorCounters::initErrors);
-            std::cerr << "TRDP tlc_openSession failed: " << err << std::endl;
-            return false;
+            auto session  = std::make_shared<InterfaceSession>();
+            session->name = iface ? iface->name : std::string{};
+            session->rx   = RxContext{this, sessions.size()};
+
+            TRDP_PROCESS_CONFIG_T ifaceProcessCfg = processCfg;
+            if (iface)
+                applyProcessSettings(ifaceProcessCfg, iface->trdpProcess);
+
+            err = tlc_openSession(&session->handle, iface ? toIp(iface->hostIp) : 0, 0, nullptr, &pdCfg, &mdCfg,
+                                  &ifaceProcessCfg);
+            if (err != TRDP_NO_ERR || !session->handle)
+            {
+                recordError(static_cast<uint32_t>(err), &TrdpErrorCounters::initErrors);
+                std::cerr << "TRDP tlc_openSession failed for interface '" << session->name << "': " << err
+                          << std::endl;
+                for (auto& opened : sessions)
+                    tlc_closeSession(opened->handle);
+                tlc_terminate();
+                return false;
+            }
+            sessions.push_back(std::move(session));
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(m_sessionsMtx);
+            m_sessions = sessions;
+            m_sessionEpoch.fetch_add(1, std::memory_order_release);
+        }
+        m_ctx.trdpSession = sessions.front()->handle;
+
+        // The default session is served by runEventLoop(); every other interface gets its own thread.
+        for (std::size_t i = 1; i < sessions.size(); ++i)
+        {
+            auto* session   = sessions[i].get();
+            session->thread = std::thread(
+                [this, session]()
+                {
+                    while (!session->stop.load())
+                        processSessionOnce(*session);
+                });
         }
 
-        return m_ctx.trdpSession != nullptr;
+        m_loop.wake();
+        return true;
     }
 
     void TrdpAdapter::deinit()
     {
+        std::vector<std::shared_ptr<InterfaceSession>> sessions;
+        {
+            std::lock_guard<std::mutex> lk(m_sessionsMtx);
+            sessions.swap(m_sessions);
+            m_sessionEpoch.fetch_add(1, std::memory_order_release);
+        }
+        for (auto& session : sessions)
+        {
+            session->stop = true;
+            session->loop.wake();
+            if (session->thread.joinable())
+                session->thread.join();
+        }
+
         if (m_ctx.trdpSession)
         {
-            tlc_closeSession(m_ctx.trdpSession);
+            for (auto& session : sessions)
+                tlc_closeSession(session->handle);
             tlc_terminate();
             m_ctx.trdpSession = nullptr;
         }
     }
 
+    std::shared_ptr<TrdpAdapter::InterfaceSession> TrdpAdapter::findSession(
+        const config::BusInterfaceConfig* iface) const
+    {
+        std::lock_guard<std::mutex> lk(m_sessionsMtx);
+        if (m_sessions.empty())
+            return nullptr;
+        if (iface)
+        {
+            for (const auto& session : m_sessions)
+                if (session->name == iface->name)
+                    return session;
+        }
+        return m_sessions.front();
+    }
+
+    TRDP_APP_SESSION_T TrdpAdapter::sessionFor(const config::BusInterfaceConfig* iface) const
+    {
+        auto session = findSession(iface);
+        return session ? session->handle : m_ctx.trdpSession;
+    }
+
+    TRDP_APP_SESSION_T TrdpAdapter::cachedSessionFor(const config::BusInterfaceConfig* iface,
+                                                     TRDP_APP_SESSION_T& cached, uint64_t& cachedEpoch) const
+    {
+        // Read the epoch first, so a lookup racing init()/deinit() is redone on the next call.
+        const auto epoch = m_sessionEpoch.load(std::memory_order_acquire);
+        if (cached && cachedEpoch == epoch)
+            return cached;
+        cached      = sessionFor(iface);
+        cachedEpoch = epoch;
+        return cached;
+    }
+
+    std::size_t TrdpAdapter::sessionCount() const
+    {
+        std::lock_guard<std::mutex> lk(m_sessionsMtx);
+        return m_sessions.size();
+    }
+
     void TrdpAdapter::applyMulticastConfig(const config::BusInterfaceConfig& iface)
     {
         for (const auto& group : iface.multicastGroups)
@@ -296,6 +432,13 @@ namespace trdp_sim::trdp
         if (!m_ctx.trdpSession || !pd.cfg || !pd.pdComCfg)
             return -1;
 
+        const auto epoch   = m_sessionEpoch.load(std::memory_order_acquire);
+        auto       session = findSession(pd.ifaceCfg);
+        if (!session)
+            return -1;
+        pd.appSession      = session->handle;
+        pd.appSessionEpoch = epoch;
+
         TRDP_IP_ADDR_T srcIp = toIp(pd.ifaceCfg->hostIp);
 
         if (pd.pubChannels.empty())
@@ -310,9 +453,9 @@ namespace trdp_sim::trdp
             if (ch.handle)
                 continue;
 
-            TRDP_ERR_T err = tlp_publish(m_ctx.trdpSession, &ch.handle, this, &pdCallback, 0, pd.cfg->comId, 0, 0,
-                                         srcIp, ch.destIp, pd.pdComCfg ? pd.pdComCfg->port : 0, 0, 0, nullptr, nullptr,
-                                         0);
+            TRDP_ERR_T err = tlp_publish(session->handle, &ch.handle, &session->rx, &pdCallback, 0, pd.cfg->comId,
+                                         0, 0, srcIp, ch.destIp, pd.pdComCfg ? pd.pdComCfg->port : 0, 0, 0, nullptr,
+                                         nullptr, 0);
 
             if (err != TRDP_NO_ERR)
             {
@@ -324,6 +467,7 @@ namespace trdp_sim::trdp
                 return -static_cast<int>(err);
             }
         }
+        session->loop.wake(); // new sockets and deadlines for the interface's I/O thread
         return 0;
     }
 
@@ -332,6 +476,13 @@ namespace trdp_sim::trdp
         if (!m_ctx.trdpSession || !pd.cfg || !pd.pdComCfg)
             return -1;
 
+        const auto epoch   = m_sessionEpoch.load(std::memory_order_acquire);
+        auto       session = findSession(pd.ifaceCfg);
+        if (!session)
+            return -1;
+        pd.appSession      = session->handle;
+        pd.appSessionEpoch = epoch;
+
         TRDP_IP_ADDR_T srcIp  = 0; // wildcard
         TRDP_IP_ADDR_T destIp = toIp(pd.ifaceCfg->hostIp);
 
@@ -342,9 +493,9 @@ namespace trdp_sim::trdp
                 : TRDP_TO_KEEP_LAST_VALUE;
         pdCfg.timeout = pd.cfg->pdParam ? pd.cfg->pdParam->timeoutUs : pd.pdComCfg->timeoutUs;
 
-        TRDP_ERR_T err = tlp_subscribe(m_ctx.trdpSession, &pd.subHandle, this, &pdCallback, 0, pd.cfg->comId, 0, 0,
-                                       srcIp, 0, destIp, pd.pdComCfg ? pd.pdComCfg->port : 0, nullptr, pdCfg.timeout,
-                                       pdCfg.toBehavior);
+        TRDP_ERR_T err = tlp_subscribe(session->handle, &pd.subHandle, &session->rx, &pdCallback, 0,
+                                       pd.cfg->comId, 0, 0, srcIp, 0, destIp, pd.pdComCfg ? pd.pdComCfg->port : 0,
+                                       nullptr, pdCfg.timeout, pdCfg.toBehavior);
 
         if (err != TRDP_NO_ERR)
         {
@@ -355,19 +506,59 @@ namespace trdp_sim::trdp
                                        buildPcapEventJson(pd.cfg->comId, 0, "rx"));
             return -static_cast<int>(err);
         }
+        session->loop.wake();
         return 0;
     }
 
-    int TrdpAdapter::sendPdData(engine::pd::PdTelegramRuntime& pd, const std::vector<uint8_t>& payload)
+    int TrdpAdapter::sendPdData(engine::pd::PdTelegramRuntime& pd, const uint8_t* data, std::size_t len)
     {
-        if (!m_ctx.trdpSession || !pd.cfg || !pd.pdComCfg)
-            return -1;
+        PdSendItem item{&pd, data, len};
+        sendPdBatch(&item, 1);
+        return item.result;
+    }
+
+    std::size_t TrdpAdapter::sendPdBatch(PdSendItem* items, std::size_t count)
+    {
+        if (count == 0)
+            return 0;
 
+        // One redundancy snapshot and one diagnostics event for the whole batch.
+        trdp_sim::SimulationControls::RedundancySimulation redundancy{};
         {
-            std::lock_guard<std::mutex> lk(m_errMtx);
-            m_lastPdPayload = payload;
+            std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
+            redundancy = m_ctx.simulation.redundancy;
         }
 
+        std::size_t sent = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto& item  = items[i];
+            item.result = transmitPd(*item.pd, item.data, item.len, redundancy);
+            if (item.result == 0 || item.result == kPdSoftDropCode)
+                ++sent;
+        }
+
+        if (sent > 0 && m_ctx.diagManager && m_ctx.diagManager->shouldLog(diag::Severity::DEBUG))
+        {
+            if (count == 1)
+                m_ctx.diagManager->log(diag::Severity::DEBUG, "PD", "PD packet transmitted",
+                                       buildPcapEventJson(items[0].pd->cfg ? items[0].pd->cfg->comId : 0, items[0].len, "tx"));
+            else
+                m_ctx.diagManager->log(diag::Severity::DEBUG, "PD", "PD batch transmitted",
+                                       std::string("{\"telegrams\":") + std::to_string(sent) + "}");
+        }
+        return sent;
+    }
+
+    int TrdpAdapter::transmitPd(engine::pd::PdTelegramRuntime& pd, const uint8_t* data, std::size_t len,
+                                const trdp_sim::SimulationControls::RedundancySimulation& redundancy)
+    {
+        if (!m_ctx.trdpSession || !pd.cfg || !pd.pdComCfg)
+            return -1;
+
+        m_sendRecorder.recordPayload(data, len);
+        const TRDP_APP_SESSION_T session = cachedSessionFor(pd.ifaceCfg, pd.appSession, pd.appSessionEpoch);
+
         if (pd.pubChannels.empty())
         {
             int rc = publishPd(pd);
@@ -378,15 +569,10 @@ namespace trdp_sim::trdp
         const bool sendRedundant = pd.cfg->pdParam && pd.cfg->pdParam->redundant > 0;
         size_t     idx           = pd.activeChannel % (pd.pubChannels.empty() ? 1 : pd.pubChannels.size());
 
-        trdp_sim::SimulationControls::RedundancySimulation redundancy{};
+        if (redundancy.forceSwitch && !pd.pubChannels.empty())
         {
-            std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
-            redundancy = m_ctx.simulation.redundancy;
-            if (redundancy.forceSwitch && !pd.pubChannels.empty())
-            {
-                idx = (idx + 1) % pd.pubChannels.size();
-                pd.stats.redundancySwitches++;
-            }
+            idx = (idx + 1) % pd.pubChannels.size();
+            pd.stats.redundancySwitches++;
         }
 
         auto sendOnce = [&](engine::pd::PdTelegramRuntime::PublicationChannel& ch, size_t channelIdx) -> int {
@@ -397,7 +583,7 @@ namespace trdp_sim::trdp
                     m_ctx.diagManager->log(diag::Severity::WARN, "PD", "Dropping PD due to simulated bus failure");
                 }
                 pd.stats.busFailureDrops++;
-                recordSendLog(pd.cfg ? pd.cfg->comId : 0, static_cast<uint32_t>(channelIdx), true);
+                m_sendRecorder.recordAttempt(pd.cfg ? pd.cfg->comId : 0, static_cast<uint32_t>(channelIdx), true);
                 return kPdSoftDropCode;
             }
             if (!ch.handle)
@@ -407,9 +593,8 @@ namespace trdp_sim::trdp
                     return rc;
             }
 
-            TRDP_ERR_T err = tlp_put(m_ctx.trdpSession, ch.handle,
-                                     const_cast<UINT8*>(payload.empty() ? nullptr : payload.data()),
-                                     static_cast<UINT32>(payload.size()));
+            TRDP_ERR_T err = tlp_put(session, ch.handle, const_cast<UINT8*>(len == 0 ? nullptr : data),
+                                     static_cast<UINT32>(len));
 
             if (err != TRDP_NO_ERR)
             {
@@ -417,10 +602,10 @@ namespace trdp_sim::trdp
                 std::cerr << "tlp_put failed for COM ID " << pd.cfg->comId << " error=" << err << std::endl;
                 if (m_ctx.diagManager)
                     m_ctx.diagManager->log(diag::Severity::ERROR, "PD", "PD send failed",
-                                           buildPcapEventJson(pd.cfg->comId, payload.size(), "tx"));
+                                           buildPcapEventJson(pd.cfg->comId, len, "tx"));
                 return -static_cast<int>(err);
             }
-            recordSendLog(pd.cfg ? pd.cfg->comId : 0, static_cast<uint32_t>(channelIdx), false);
+            m_sendRecorder.recordAttempt(pd.cfg ? pd.cfg->comId : 0, static_cast<uint32_t>(channelIdx), false);
             return 0;
         };
 
@@ -462,15 +647,11 @@ namespace trdp_sim::trdp
         }
 
         if (m_ctx.diagManager)
-        {
-            m_ctx.diagManager->writePacketToPcap(payload.data(), payload.size(), true);
-            m_ctx.diagManager->log(diag::Severity::DEBUG, "PD", "PD packet transmitted",
-                                   buildPcapEventJson(pd.cfg->comId, payload.size(), "tx"));
-        }
+            m_ctx.diagManager->writePacketToPcap(data, len, true);
         return 0;
     }
 
-    void TrdpAdapter::handlePdCallback(uint32_t comId, const uint8_t* data, std::size_t len)
+    void TrdpAdapter::handlePdCallback(uint32_t comId, const uint8_t* data, std::size_t len, std::size_t rxChannel)
     {
         if (m_ctx.diagManager)
         {
@@ -481,15 +662,16 @@ namespace trdp_sim::trdp
 
         if (m_ctx.pdEngine)
         {
-            m_ctx.pdEngine->onPdReceived(comId, data, len);
+            m_ctx.pdEngine->onPdReceived(comId, data, len, rxChannel);
             return;
         }
 
-        for (auto& pdPtr : m_ctx.pdTelegrams)
-        {
-            if (!pdPtr || !pdPtr->cfg || pdPtr->cfg->comId != comId)
-                continue;
+        auto subs = m_ctx.pdSubscribersByComId.find(comId);
+        if (subs == m_ctx.pdSubscribersByComId.end())
+            return;
 
+        for (auto* pdPtr : subs->second)
+        {
             std::lock_guard<std::mutex> lk(pdPtr->mtx);
             pdPtr->stats.rxCount++;
             pdPtr->stats.lastRxTime = std::chrono::steady_clock::now();
@@ -515,8 +697,9 @@ namespace trdp_sim::trdp
 
         TRDP_URI_USER_T srcUri{};
         TRDP_URI_USER_T destUri{};
-        TRDP_ERR_T      err = tlm_request(
-            m_ctx.trdpSession, this, &mdCallback, &session.trdpSessionId, session.telegram->comId, 0, 0, 0, destIp, 0, 0,
+        const auto      appSession = cachedSessionFor(session.iface, session.appSession, session.appSessionEpoch);
+        TRDP_ERR_T      err        = tlm_request(
+            appSession, this, &mdCallback, &session.trdpSessionId, session.telegram->comId, 0, 0, 0, destIp, 0, 0,
             0, nullptr, const_cast<UINT8*>(payload.empty() ? nullptr : payload.data()),
             static_cast<UINT32>(payload.size()), srcUri, destUri);
 
@@ -549,8 +732,9 @@ namespace trdp_sim::trdp
             m_lastMdReplyPayload = payload;
         }
 
-        TRDP_ERR_T err = tlm_reply(
-            m_ctx.trdpSession, &session.trdpSessionId, session.telegram->comId, 0, nullptr,
+        const auto appSession = cachedSessionFor(session.iface, session.appSession, session.appSessionEpoch);
+        TRDP_ERR_T err        = tlm_reply(
+            appSession, &session.trdpSessionId, session.telegram->comId, 0, nullptr,
             const_cast<UINT8*>(payload.empty() ? nullptr : payload.data()), static_cast<UINT32>(payload.size()), nullptr);
 
         if (err != TRDP_NO_ERR)
@@ -610,38 +794,83 @@ namespace trdp_sim::trdp
 
     void TrdpAdapter::processOnce()
     {
-        if (!m_ctx.trdpSession)
+        auto session = findSession(nullptr);
+        if (!session)
+        {
+            std::vector<int> ready;
+            if (!m_loop.valid())
+            {
+                recordError(0, &TrdpErrorCounters::eventLoopErrors);
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                return;
+            }
+            // Nothing to serve until init() wakes the loop.
+            m_loop.wait(std::nullopt, ready);
+            return;
+        }
+        processSessionOnce(*session);
+    }
+
+    void TrdpAdapter::processSessionOnce(InterfaceSession& session)
+    {
+        std::vector<int> ready;
+        if (!session.loop.valid())
+        {
+            recordError(0, &TrdpErrorCounters::eventLoopErrors);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
             return;
+        }
 
         TRDP_FDS_T  rfds;
-        TRDP_TIME_T interval;
+        TRDP_TIME_T interval{};
         INT32       noOfDesc = 0;
 
         FD_ZERO(&rfds);
 
-        if (tlc_getInterval(m_ctx.trdpSession, &interval, &rfds, &noOfDesc) != TRDP_NO_ERR)
+        if (tlc_getInterval(session.handle, &interval, &rfds, &noOfDesc) != TRDP_NO_ERR)
         {
             recordError(0, &TrdpErrorCounters::eventLoopErrors);
             return;
         }
 
-        struct timeval tv;
-        tv.tv_sec  = interval.tv_sec;
-        tv.tv_usec = interval.tv_usec;
+        // TRDP still reports its sockets as an fd_set; the waiting is done by epoll.
+        std::vector<int> fds;
+        for (int fd = 0; fd <= noOfDesc && fd < FD_SETSIZE; ++fd)
+            if (FD_ISSET(fd, &rfds))
+                fds.push_back(fd);
+        session.loop.watch(fds);
 
-        int rv = select(noOfDesc + 1, &rfds, nullptr, nullptr, &tv);
-        if (rv < 0)
+        const auto timeout = std::chrono::seconds(interval.tv_sec) + std::chrono::microseconds(interval.tv_usec);
+        if (session.loop.wait(timeout, ready) < 0)
         {
-            std::perror("select");
-            recordError(errno, &TrdpErrorCounters::eventLoopErrors);
+            recordError(static_cast<uint32_t>(errno), &TrdpErrorCounters::eventLoopErrors);
             return;
         }
 
-        auto err = tlc_process(m_ctx.trdpSession, &rfds, nullptr);
+        FD_ZERO(&rfds);
+        for (int fd : ready)
+            FD_SET(fd, &rfds);
+        INT32 count = static_cast<INT32>(ready.size());
+        auto  err   = tlc_process(session.handle, &rfds, &count);
         if (err != TRDP_NO_ERR)
             recordError(static_cast<uint32_t>(err), &TrdpErrorCounters::eventLoopErrors);
     }
 
+    void TrdpAdapter::runEventLoop()
+    {
+        while (!m_loopStop.load())
+            processOnce();
+        m_loopStop = false;
+    }
+
+    void TrdpAdapter::stopEventLoop()
+    {
+        m_loopStop = true;
+        m_loop.wake();
+        if (auto session = findSession(nullptr))
+            session->loop.wake();
+    }
+
     TrdpErrorCounters TrdpAdapter::getErrorCounters() const
     {
         std::lock_guard<std::mutex> lk(m_errMtx);
@@ -656,8 +885,7 @@ namespace trdp_sim::trdp
 
     std::vector<uint8_t> TrdpAdapter::getLastPdPayload() const
     {
-        std::lock_guard<std::mutex> lk(m_errMtx);
-        return m_lastPdPayload;
+        return m_sendRecorder.lastPayload();
     }
 
     std::vector<uint8_t> TrdpAdapter::getLastMdRequestPayload() const
@@ -674,8 +902,7 @@ namespace trdp_sim::trdp
 
     std::vector<PdSendLogEntry> TrdpAdapter::getPdSendLog() const
     {
-        std::lock_guard<std::mutex> lk(m_errMtx);
-        return m_pdSendLog;
+        return m_sendRecorder.entries();
     }
 
     std::vector<uint32_t> TrdpAdapter::getRequestedSessions() const
@@ -697,12 +924,4 @@ namespace trdp_sim::trdp
         m_lastErrorCode = code;
     }
 
-    void TrdpAdapter::recordSendLog(uint32_t comId, uint32_t channel, bool dropped) const
-    {
-        std::lock_guard<std::mutex> lk(m_errMtx);
-        if (m_pdSendLog.size() > 63)
-            m_pdSendLog.erase(m_pdSendLog.begin());
-        m_pdSendLog.push_back(PdSendLogEntry{comId, channel, dropped});
-    }
-
 } // namespace trdp_sim::trdp
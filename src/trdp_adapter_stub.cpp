@@ -5,8 +5,11 @@
 #include "trdp_adapter.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstring>
 #include <mutex>
+#include <thread>
 
 #include <nlohmann/json.hpp>
 
@@ -52,19 +55,72 @@ namespace trdp_sim::trdp
 
     } // namespace
 
-    TrdpAdapter::TrdpAdapter(EngineContext& ctx) : m_ctx(ctx) {}
+    TrdpAdapter::TrdpAdapter(EngineContext& ctx) : m_ctx(ctx)
+    {
+        // The stub exists for tests, which inspect what would have been sent.
+        m_sendRecorder.setEnabled(true);
+    }
 
     bool TrdpAdapter::init()
     {
-        m_ctx.trdpSession = reinterpret_cast<TRDP_APP_SESSION_T>(0x1);
+        // Distinct fake handles per interface so tests can check the routing; no I/O threads.
+        std::vector<std::shared_ptr<InterfaceSession>> sessions;
+        const std::size_t count = std::max<std::size_t>(1, m_ctx.deviceConfig.interfaces.size());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto session    = std::make_shared<InterfaceSession>();
+            session->name   = i < m_ctx.deviceConfig.interfaces.size() ? m_ctx.deviceConfig.interfaces[i].name
+                                                                       : std::string{};
+            session->handle = reinterpret_cast<TRDP_APP_SESSION_T>(0x1 + i);
+            session->rx     = RxContext{this, i};
+            sessions.push_back(std::move(session));
+        }
+        {
+            std::lock_guard<std::mutex> lk(m_sessionsMtx);
+            m_sessions = sessions;
+            m_sessionEpoch.fetch_add(1, std::memory_order_release);
+        }
+        m_ctx.trdpSession = sessions.front()->handle;
         return true;
     }
 
     void TrdpAdapter::deinit()
     {
+        {
+            std::lock_guard<std::mutex> lk(m_sessionsMtx);
+            m_sessions.clear();
+            m_sessionEpoch.fetch_add(1, std::memory_order_release);
+        }
         m_ctx.trdpSession = nullptr;
     }
 
+    std::shared_ptr<TrdpAdapter::InterfaceSession> TrdpAdapter::findSession(
+        const config::BusInterfaceConfig* iface) const
+    {
+        std::lock_guard<std::mutex> lk(m_sessionsMtx);
+        if (m_sessions.empty())
+            return nullptr;
+        if (iface)
+        {
+            for (const auto& session : m_sessions)
+                if (session->name == iface->name)
+                    return session;
+        }
+        return m_sessions.front();
+    }
+
+    TRDP_APP_SESSION_T TrdpAdapter::sessionFor(const config::BusInterfaceConfig* iface) const
+    {
+        auto session = findSession(iface);
+        return session ? session->handle : m_ctx.trdpSession;
+    }
+
+    std::size_t TrdpAdapter::sessionCount() const
+    {
+        std::lock_guard<std::mutex> lk(m_sessionsMtx);
+        return m_sessions.size();
+    }
+
     void TrdpAdapter::applyMulticastConfig(const config::BusInterfaceConfig& iface)
     {
         for (const auto& group : iface.multicastGroups)
@@ -149,34 +205,74 @@ namespace trdp_sim::trdp
         return 0;
     }
 
-    int TrdpAdapter::sendPdData(engine::pd::PdTelegramRuntime& pd, const std::vector<uint8_t>& payload)
+    int TrdpAdapter::sendPdData(engine::pd::PdTelegramRuntime& pd, const uint8_t* data, std::size_t len)
+    {
+        PdSendItem item{&pd, data, len};
+        sendPdBatch(&item, 1);
+        return item.result;
+    }
+
+    std::size_t TrdpAdapter::sendPdBatch(PdSendItem* items, std::size_t count)
     {
+        if (count == 0)
+            return 0;
+
         const int rcOverride = m_pdSendResult.value_or(0);
         if (rcOverride != 0)
         {
-            recordError(static_cast<uint32_t>(-rcOverride), &TrdpErrorCounters::pdSendErrors);
-            return rcOverride;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                items[i].result = rcOverride;
+                recordError(static_cast<uint32_t>(-rcOverride), &TrdpErrorCounters::pdSendErrors);
+            }
+            return 0;
         }
 
+        // One redundancy snapshot and one diagnostics event for the whole batch.
         trdp_sim::SimulationControls::RedundancySimulation redundancy{};
         {
             std::lock_guard<std::mutex> lk(m_ctx.simulation.mtx);
             redundancy = m_ctx.simulation.redundancy;
-            if (redundancy.forceSwitch && !pd.pubChannels.empty())
-            {
-                pd.activeChannel = static_cast<uint32_t>((pd.activeChannel + 1) % pd.pubChannels.size());
-                pd.stats.redundancySwitches++;
-            }
+        }
+
+        std::size_t sent = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto& item  = items[i];
+            item.result = transmitPd(*item.pd, item.data, item.len, redundancy);
+            if (item.result == 0 || item.result == kPdSoftDropCode)
+                ++sent;
+        }
+
+        if (sent > 0 && m_ctx.diagManager && m_ctx.diagManager->shouldLog(diag::Severity::DEBUG))
+        {
+            if (count == 1)
+                m_ctx.diagManager->log(diag::Severity::DEBUG, "PD", "PD packet transmitted",
+                                       buildPcapEventJson(items[0].pd->cfg ? items[0].pd->cfg->comId : 0, items[0].len, "tx"));
+            else
+                m_ctx.diagManager->log(diag::Severity::DEBUG, "PD", "PD batch transmitted",
+                                       std::string("{\"telegrams\":") + std::to_string(sent) + "}");
+        }
+        return sent;
+    }
+
+    int TrdpAdapter::transmitPd(engine::pd::PdTelegramRuntime& pd, const uint8_t* data, std::size_t len,
+                                const trdp_sim::SimulationControls::RedundancySimulation& redundancy)
+    {
+        if (redundancy.forceSwitch && !pd.pubChannels.empty())
+        {
+            pd.activeChannel = static_cast<uint32_t>((pd.activeChannel + 1) % pd.pubChannels.size());
+            pd.stats.redundancySwitches++;
         }
 
         auto sendOnce = [&](std::size_t channelIdx) -> int {
             if (redundancy.busFailure && redundancy.failedChannel == channelIdx)
             {
                 pd.stats.busFailureDrops++;
-                recordSendLog(pd.cfg ? pd.cfg->comId : 0, static_cast<uint32_t>(channelIdx), true);
+                m_sendRecorder.recordAttempt(pd.cfg ? pd.cfg->comId : 0, static_cast<uint32_t>(channelIdx), true);
                 return kPdSoftDropCode;
             }
-            recordSendLog(pd.cfg ? pd.cfg->comId : 0, static_cast<uint32_t>(channelIdx), false);
+            m_sendRecorder.recordAttempt(pd.cfg ? pd.cfg->comId : 0, static_cast<uint32_t>(channelIdx), false);
             return 0;
         };
 
@@ -213,16 +309,9 @@ namespace trdp_sim::trdp
                 return rc;
         }
 
-        {
-            std::lock_guard<std::mutex> lk(m_errMtx);
-            m_lastPdPayload = payload;
-        }
+        m_sendRecorder.recordPayload(data, len);
         if (m_ctx.diagManager)
-        {
-            m_ctx.diagManager->writePacketToPcap(payload.data(), payload.size(), true);
-            m_ctx.diagManager->log(diag::Severity::DEBUG, "PD", "PD packet transmitted",
-                                   buildPcapEventJson(pd.cfg ? pd.cfg->comId : 0, payload.size(), "tx"));
-        }
+            m_ctx.diagManager->writePacketToPcap(data, len, true);
         if (sentSuccessfully)
             return 0;
         if (dropCode)
@@ -230,7 +319,7 @@ namespace trdp_sim::trdp
         return 0;
     }
 
-    void TrdpAdapter::handlePdCallback(uint32_t comId, const uint8_t* data, std::size_t len)
+    void TrdpAdapter::handlePdCallback(uint32_t comId, const uint8_t* data, std::size_t len, std::size_t rxChannel)
     {
         if (m_ctx.diagManager)
         {
@@ -240,7 +329,7 @@ namespace trdp_sim::trdp
         }
         if (m_ctx.pdEngine)
         {
-            m_ctx.pdEngine->onPdReceived(comId, data, len);
+            m_ctx.pdEngine->onPdReceived(comId, data, len, rxChannel);
         }
     }
 
@@ -252,6 +341,12 @@ namespace trdp_sim::trdp
             recordError(static_cast<uint32_t>(-rc), &TrdpErrorCounters::mdRequestErrors);
             return rc;
         }
+        // Like tlm_request, every request gets a fresh session UUID.
+        static std::atomic<uint64_t> nextUuid{1};
+        const uint64_t               uuid = nextUuid.fetch_add(1, std::memory_order_relaxed);
+        session.trdpSessionId = TRDP_UUID_T{};
+        std::memcpy(session.trdpSessionId.value, &uuid, std::min(sizeof(uuid), sizeof(session.trdpSessionId.value)));
+
         std::lock_guard<std::mutex> lk(m_errMtx);
         m_requestedSessions.push_back(session.sessionId);
         m_lastMdRequestPayload = payload;
@@ -303,6 +398,24 @@ namespace trdp_sim::trdp
 
     void TrdpAdapter::processOnce() {}
 
+    void TrdpAdapter::runEventLoop()
+    {
+        // The stub has no sockets or timers: sleep until stopEventLoop().
+        std::vector<int> ready;
+        while (!m_loopStop.load())
+        {
+            if (m_loop.wait(std::nullopt, ready) < 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        m_loopStop = false;
+    }
+
+    void TrdpAdapter::stopEventLoop()
+    {
+        m_loopStop = true;
+        m_loop.wake();
+    }
+
     TrdpErrorCounters TrdpAdapter::getErrorCounters() const
     {
         std::lock_guard<std::mutex> lk(m_errMtx);
@@ -317,8 +430,7 @@ namespace trdp_sim::trdp
 
     std::vector<PdSendLogEntry> TrdpAdapter::getPdSendLog() const
     {
-        std::lock_guard<std::mutex> lk(m_errMtx);
-        return m_pdSendLog;
+        return m_sendRecorder.entries();
     }
 
     void TrdpAdapter::recordError(uint32_t code, uint64_t TrdpErrorCounters::* member)
@@ -328,14 +440,6 @@ namespace trdp_sim::trdp
         m_lastErrorCode = code;
     }
 
-    void TrdpAdapter::recordSendLog(uint32_t comId, uint32_t channel, bool dropped) const
-    {
-        std::lock_guard<std::mutex> lk(m_errMtx);
-        if (m_pdSendLog.size() > 63)
-            m_pdSendLog.erase(m_pdSendLog.begin());
-        m_pdSendLog.push_back(PdSendLogEntry{comId, channel, dropped});
-    }
-
     std::vector<trdp_sim::EngineContext::MulticastGroupState> TrdpAdapter::getMulticastState() const
     {
         std::lock_guard<std::mutex> lk(m_ctx.multicastMtx);
@@ -344,8 +448,7 @@ namespace trdp_sim::trdp
 
     std::vector<uint8_t> TrdpAdapter::getLastPdPayload() const
     {
-        std::lock_guard<std::mutex> lk(m_errMtx);
-        return m_lastPdPayload;
+        return m_sendRecorder.lastPayload();
     }
 
     std::vector<uint8_t> TrdpAdapter::getLastMdRequestPayload() const
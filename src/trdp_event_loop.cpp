@@ -0,0 +1,178 @@
+#include "trdp_event_loop.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+namespace trdp_sim::trdp
+{
+
+    namespace
+    {
+
+        constexpr std::size_t kMaxEvents = 64;
+        // A later deadline within this window keeps the armed one; the early wakeup only costs
+        // one extra pass, while re-arming for every recomputed TRDP interval costs a syscall.
+        constexpr int64_t kRearmSlackNs = 100 * 1000;
+
+        bool addReadable(int epollFd, int fd)
+        {
+            epoll_event ev{};
+            ev.events  = EPOLLIN | EPOLLRDHUP;
+            ev.data.fd = fd;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0)
+                return true;
+            return errno == EEXIST && epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) == 0;
+        }
+
+        int64_t monotonicNs()
+        {
+            timespec ts{};
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+        }
+
+        void drain(int fd)
+        {
+            uint64_t value = 0;
+            while (::read(fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)))
+            {
+            }
+        }
+
+    } // namespace
+
+    EventLoop::EventLoop()
+    {
+        m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+        m_wakeFd  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        m_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (m_epollFd < 0 || m_wakeFd < 0 || m_timerFd < 0 || !addReadable(m_epollFd, m_wakeFd) ||
+            !addReadable(m_epollFd, m_timerFd))
+        {
+            for (int fd : {m_epollFd, m_wakeFd, m_timerFd})
+                if (fd >= 0)
+                    ::close(fd);
+            m_epollFd = m_wakeFd = m_timerFd = -1;
+        }
+    }
+
+    EventLoop::~EventLoop()
+    {
+        for (int fd : {m_epollFd, m_wakeFd, m_timerFd})
+            if (fd >= 0)
+                ::close(fd);
+    }
+
+    void EventLoop::watch(const std::vector<int>& fds)
+    {
+        if (!valid())
+            return;
+        m_scratch.assign(fds.begin(), fds.end());
+        std::sort(m_scratch.begin(), m_scratch.end());
+        m_scratch.erase(std::unique(m_scratch.begin(), m_scratch.end()), m_scratch.end());
+        if (m_scratch == m_watched)
+            return;
+
+        // Walk both sorted sets once: descriptors only in the old set are removed, those only
+        // in the new one are added, and unchanged ones are left alone.
+        m_merged.clear();
+        auto oldIt = m_watched.begin();
+        auto newIt = m_scratch.begin();
+        while (oldIt != m_watched.end() || newIt != m_scratch.end())
+        {
+            if (newIt == m_scratch.end() || (oldIt != m_watched.end() && *oldIt < *newIt))
+            {
+                // The stack may already have closed it; EBADF/ENOENT are harmless here.
+                epoll_ctl(m_epollFd, EPOLL_CTL_DEL, *oldIt++, nullptr);
+            }
+            else if (oldIt == m_watched.end() || *newIt < *oldIt)
+            {
+                if (addReadable(m_epollFd, *newIt))
+                    m_merged.push_back(*newIt);
+                ++newIt;
+            }
+            else
+            {
+                m_merged.push_back(*newIt);
+                ++oldIt;
+                ++newIt;
+            }
+        }
+        m_watched.swap(m_merged);
+    }
+
+    void EventLoop::forget(int fd)
+    {
+        auto it = std::lower_bound(m_watched.begin(), m_watched.end(), fd);
+        if (it == m_watched.end() || *it != fd)
+            return;
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        m_watched.erase(it);
+    }
+
+    void EventLoop::armTimer(std::optional<std::chrono::microseconds> timeout)
+    {
+        // The timerfd runs on an absolute deadline, so an unchanged one needs no syscall.
+        int64_t deadline = 0;
+        if (timeout)
+        {
+            deadline = monotonicNs() + std::chrono::nanoseconds(*timeout).count();
+            if (m_armedNs != 0 && deadline >= m_armedNs && deadline - m_armedNs < kRearmSlackNs)
+                return;
+        }
+        else if (m_armedNs == 0)
+        {
+            return;
+        }
+
+        itimerspec spec{};
+        spec.it_value.tv_sec  = static_cast<time_t>(deadline / 1000000000);
+        spec.it_value.tv_nsec = static_cast<long>(deadline % 1000000000);
+        if (timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) == 0)
+            m_armedNs = deadline;
+    }
+
+    int EventLoop::wait(std::optional<std::chrono::microseconds> timeout, std::vector<int>& ready)
+    {
+        ready.clear();
+        if (!valid())
+            return -1;
+
+        armTimer(timeout);
+        epoll_event events[kMaxEvents];
+        int         n = epoll_wait(m_epollFd, events, static_cast<int>(kMaxEvents), -1);
+        if (n < 0)
+            return errno == EINTR ? 0 : -1;
+
+        for (int i = 0; i < n; ++i)
+        {
+            const int fd = events[i].data.fd;
+            if (fd == m_wakeFd || fd == m_timerFd)
+            {
+                drain(fd);
+                if (fd == m_timerFd)
+                    m_armedNs = 0;
+                continue;
+            }
+            ready.push_back(fd);
+            if (events[i].events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP))
+                forget(fd);
+        }
+        return static_cast<int>(ready.size());
+    }
+
+    void EventLoop::wake()
+    {
+        if (m_wakeFd < 0)
+            return;
+        const uint64_t one = 1;
+        (void) ::write(m_wakeFd, &one, sizeof(one));
+    }
+
+} // namespace trdp_sim::trdp
@@ -0,0 +1,120 @@
+// Compares legacy per-element marshalling with compiled MarshalPlans on the
+// datasets of a device configuration (default: config/sample_ci_device.xml),
+// plus a synthetic nested dataset where the legacy path recurses per call.
+//
+//   marshal-plan-bench [config.xml] [iterations]
+
+#include "config_manager.hpp"
+#include "data_marshalling.hpp"
+#include "engine_context.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#ifndef TRDP_BENCH_DEFAULT_CONFIG
+#define TRDP_BENCH_DEFAULT_CONFIG "config/sample_ci_device.xml"
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double nsPerOp(Clock::duration d, std::size_t ops)
+    {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()) /
+               static_cast<double>(ops);
+    }
+
+    void fillValues(data::DataSetInstance& inst, const trdp_sim::EngineContext& ctx)
+    {
+        inst.values.resize(inst.def->elements.size());
+        for (std::size_t i = 0; i < inst.values.size(); ++i)
+        {
+            auto& cell   = inst.values[i];
+            cell.defined = true;
+            cell.raw.assign(trdp_sim::util::elementSize(inst.def->elements[i], ctx), static_cast<uint8_t>(i + 1));
+        }
+    }
+
+    void runDataset(const trdp_sim::EngineContext& ctx, const data::DataSetDef& def, std::size_t iterations)
+    {
+        data::DataSetInstance legacy;
+        legacy.def = &def;
+        fillValues(legacy, ctx);
+        data::DataSetInstance planned;
+        planned.def    = &def;
+        planned.plan   = trdp_sim::util::compileMarshalPlan(def, ctx);
+        planned.values = legacy.values;
+
+        std::size_t sink = 0;
+        const auto  time = [&](data::DataSetInstance& inst, bool roundTrip)
+        {
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                auto bytes = trdp_sim::util::marshalDataSet(inst, ctx);
+                if (roundTrip)
+                    trdp_sim::util::unmarshalDataToDataSet(inst, ctx, bytes.data(), bytes.size());
+                sink += bytes.size();
+            }
+            return Clock::now() - start;
+        };
+
+        const auto legacyMarshal  = time(legacy, false);
+        const auto planMarshal    = time(planned, false);
+        const auto legacyRoundTrip = time(legacy, true);
+        const auto planRoundTrip   = time(planned, true);
+
+        std::printf("%-18s %6zu B  marshal %8.1f -> %8.1f ns (x%.2f)  round-trip %8.1f -> %8.1f ns (x%.2f)\n",
+                    def.name.c_str(), planned.plan ? planned.plan->totalSize : 0, nsPerOp(legacyMarshal, iterations),
+                    nsPerOp(planMarshal, iterations),
+                    nsPerOp(legacyMarshal, iterations) / nsPerOp(planMarshal, iterations),
+                    nsPerOp(legacyRoundTrip, iterations), nsPerOp(planRoundTrip, iterations),
+                    nsPerOp(legacyRoundTrip, iterations) / nsPerOp(planRoundTrip, iterations));
+        if (sink == 0)
+            std::printf("(empty dataset)\n");
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::string path       = argc > 1 ? argv[1] : TRDP_BENCH_DEFAULT_CONFIG;
+    const std::size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+
+    trdp_sim::EngineContext ctx;
+    config::ConfigManager   mgr;
+    try
+    {
+        ctx.deviceConfig = mgr.loadDeviceConfigFromXml(path);
+    }
+    catch (const std::exception& ex)
+    {
+        std::fprintf(stderr, "Failed to load %s: %s\n", path.c_str(), ex.what());
+        return 1;
+    }
+    for (auto& def : mgr.buildDataSetDefs(ctx.deviceConfig))
+        ctx.dataSetDefs[def.id] = def;
+
+    // Synthetic nested layout: 8 x (UINT32, 4 x UINT16, 2 x (REAL64, UINT8)).
+    data::DataSetDef leaf{0xFFF0, "bench-leaf", {{"v", data::ElementType::REAL64, 1, std::nullopt},
+                                                 {"f", data::ElementType::UINT8, 1, std::nullopt}}};
+    data::DataSetDef mid{0xFFF1, "bench-mid", {{"id", data::ElementType::UINT32, 1, std::nullopt},
+                                               {"w", data::ElementType::UINT16, 4, std::nullopt},
+                                               {"leaf", data::ElementType::NESTED_DATASET, 2, leaf.id}}};
+    data::DataSetDef top{0xFFF2, "bench-nested", {}};
+    for (int i = 0; i < 8; ++i)
+        top.elements.push_back({"m" + std::to_string(i), data::ElementType::NESTED_DATASET, 1, mid.id});
+    ctx.dataSetDefs[leaf.id] = leaf;
+    ctx.dataSetDefs[mid.id]  = mid;
+    ctx.dataSetDefs[top.id]  = top;
+
+    std::printf("%s, %zu iterations per measurement\n", path.c_str(), iterations);
+    for (const auto& [id, def] : ctx.dataSetDefs)
+    {
+        if (id != leaf.id && id != mid.id)
+            runDataset(ctx, def, iterations);
+    }
+    return 0;
+}
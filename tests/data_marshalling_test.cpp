@@ -3,6 +3,8 @@
 #include "data_marshalling.hpp"
 
 #include <array>
+#include <atomic>
+#include <thread>
 
 using trdp_sim::EngineContext;
 using trdp_sim::util::marshalDataSet;
@@ -64,3 +66,183 @@ TEST(DataMarshalling, UndefinedElementsAreZeroed)
     ASSERT_EQ(payload.size(), 4u);
     EXPECT_EQ(payload, (std::vector<uint8_t>{0, 0, 0, 0}));
 }
+
+TEST(DataMarshalling, CompiledPlanMatchesLegacyForNestedDatasets)
+{
+    EngineContext    ctx;
+    data::DataSetDef inner;
+    inner.id       = 10;
+    inner.name     = "Inner";
+    inner.elements = {{"x", data::ElementType::UINT16, 1, std::nullopt},
+                      {"y", data::ElementType::UINT8, 2, std::nullopt}};
+    data::DataSetDef outer;
+    outer.id       = 11;
+    outer.name     = "Outer";
+    outer.elements = {{"head", data::ElementType::UINT32, 1, std::nullopt},
+                      {"inner", data::ElementType::NESTED_DATASET, 2, 10u},
+                      {"tail", data::ElementType::CHAR8, 3, std::nullopt}};
+    ctx.dataSetDefs[inner.id] = inner;
+    ctx.dataSetDefs[outer.id] = outer;
+
+    auto plan = trdp_sim::util::compileMarshalPlan(ctx.dataSetDefs[outer.id], ctx);
+    ASSERT_NE(plan, nullptr);
+    EXPECT_EQ(plan->totalSize, 4u + 2u * 4u + 3u);
+    ASSERT_EQ(plan->slots.size(), 3u);
+    EXPECT_EQ(plan->slots[1].offset, 4u);
+    EXPECT_EQ(plan->slots[2].offset, 12u);
+
+    data::DataSetInstance legacy;
+    legacy.def = &ctx.dataSetDefs[outer.id];
+    legacy.values.resize(outer.elements.size());
+    legacy.values[0].defined = true;
+    legacy.values[0].raw     = {1, 2, 3, 4};
+    legacy.values[1].defined = true;
+    legacy.values[1].raw     = {9, 8, 7};
+    data::DataSetInstance planned;
+    planned.def    = legacy.def;
+    planned.plan   = plan;
+    planned.values = legacy.values;
+
+    const auto expected = marshalDataSet(legacy, ctx);
+    EXPECT_EQ(marshalDataSet(planned, ctx), expected);
+
+    unmarshalDataToDataSet(planned, ctx, expected.data(), 10);
+    unmarshalDataToDataSet(legacy, ctx, expected.data(), 10);
+    for (std::size_t i = 0; i < legacy.values.size(); ++i)
+    {
+        EXPECT_EQ(planned.values[i].defined, legacy.values[i].defined);
+        EXPECT_EQ(planned.values[i].raw, legacy.values[i].raw);
+    }
+}
+
+TEST(DataMarshalling, ContiguousLayoutMarshalsThroughAccessors)
+{
+    EngineContext    ctx;
+    data::DataSetDef def;
+    def.id                  = 3;
+    def.name                = "Contiguous";
+    def.elements            = {{"a", data::ElementType::UINT16, 1, std::nullopt},
+                               {"b", data::ElementType::CHAR8, 4, std::nullopt},
+                               {"c", data::ElementType::UINT8, 1, std::nullopt}};
+    ctx.dataSetDefs[def.id] = def;
+
+    data::DataSetInstance inst;
+    inst.def = &ctx.dataSetDefs[def.id];
+    inst.values.resize(def.elements.size());
+    inst.values[0].defined = true;
+    inst.values[0].raw     = {0x34, 0x12};
+    inst.plan              = trdp_sim::util::compileMarshalPlan(*inst.def, ctx);
+    ASSERT_TRUE(data::enableContiguousStorage(inst));
+    EXPECT_TRUE(inst.values.empty());
+    EXPECT_EQ(data::elementCount(inst), 3u);
+    EXPECT_TRUE(data::isElementDefined(inst, 0));
+    EXPECT_FALSE(data::isElementDefined(inst, 1));
+    EXPECT_EQ(data::elementBytes(inst, 1), (std::vector<uint8_t>{0, 0, 0, 0}));
+
+    const std::array<uint8_t, 2> text{'H', 'I'};
+    data::setElementBytes(inst, 1, text.data(), text.size());
+    EXPECT_EQ(data::elementBytes(inst, 1), (std::vector<uint8_t>{'H', 'I', 0, 0}));
+    EXPECT_EQ(marshalDataSet(inst, ctx), (std::vector<uint8_t>{0x34, 0x12, 'H', 'I', 0, 0, 0}));
+
+    data::clearElement(inst, 0);
+    EXPECT_FALSE(data::isElementDefined(inst, 0));
+    EXPECT_EQ(marshalDataSet(inst, ctx)[0], 0);
+
+    const std::array<uint8_t, 4> partial{1, 2, 3, 4};
+    unmarshalDataToDataSet(inst, ctx, partial.data(), partial.size());
+    EXPECT_TRUE(data::isElementDefined(inst, 1));
+    EXPECT_FALSE(data::isElementDefined(inst, 2));
+    EXPECT_EQ(data::elementBytes(inst, 1), (std::vector<uint8_t>{3, 4, 0, 0}));
+}
+
+TEST(DataMarshalling, ContiguousWritesPublishTearFreeSnapshots)
+{
+    EngineContext    ctx;
+    data::DataSetDef def;
+    def.id                  = 4;
+    def.name                = "Published";
+    def.elements            = {{"a", data::ElementType::UINT32, 1, std::nullopt},
+                               {"b", data::ElementType::UINT32, 1, std::nullopt}};
+    ctx.dataSetDefs[def.id] = def;
+
+    data::DataSetInstance inst;
+    inst.def = &ctx.dataSetDefs[def.id];
+    inst.values.resize(def.elements.size());
+    inst.plan = trdp_sim::util::compileMarshalPlan(*inst.def, ctx);
+    ASSERT_TRUE(data::enableContiguousStorage(inst));
+
+    auto first = data::publishedSnapshot(inst);
+    ASSERT_NE(first, nullptr);
+
+    // Writers fill both elements with the same byte; readers must never see a mix.
+    std::atomic<bool> done{false};
+    std::thread       writer(
+        [&]
+        {
+            for (uint8_t v = 1; v < 200; ++v)
+            {
+                const std::array<uint8_t, 8> frame{v, v, v, v, v, v, v, v};
+                std::lock_guard<std::mutex>  lk(inst.mtx);
+                unmarshalDataToDataSet(inst, ctx, frame.data(), frame.size());
+            }
+            done = true;
+        });
+    while (!done.load())
+    {
+        auto snap = data::publishedSnapshot(inst);
+        ASSERT_EQ(snap->bytes.size(), 8u);
+        for (auto b : snap->bytes)
+            ASSERT_EQ(b, snap->bytes.front());
+    }
+    writer.join();
+
+    auto last = data::publishedSnapshot(inst);
+    EXPECT_GT(last->generation, first->generation);
+    EXPECT_EQ(last->bytes, marshalDataSet(inst, ctx));
+}
+
+TEST(DataMarshalling, ContiguousBatchPublishesOnceAndRecyclesSnapshots)
+{
+    EngineContext    ctx;
+    data::DataSetDef def;
+    def.id                  = 5;
+    def.name                = "Batched";
+    def.elements            = {{"a", data::ElementType::UINT8, 1, std::nullopt},
+                               {"b", data::ElementType::UINT8, 1, std::nullopt},
+                               {"c", data::ElementType::UINT8, 1, std::nullopt}};
+    ctx.dataSetDefs[def.id] = def;
+
+    data::DataSetInstance inst;
+    inst.def = &ctx.dataSetDefs[def.id];
+    inst.values.resize(def.elements.size());
+    inst.plan = trdp_sim::util::compileMarshalPlan(*inst.def, ctx);
+    ASSERT_TRUE(data::enableContiguousStorage(inst));
+
+    const auto* before = data::publishedSnapshot(inst).get();
+    {
+        data::DataSetWriteBatch batch(inst);
+        for (std::size_t idx = 0; idx < data::elementCount(inst); ++idx)
+        {
+            const uint8_t v = static_cast<uint8_t>(idx + 1);
+            data::setElementBytes(inst, idx, &v, 1);
+        }
+        EXPECT_EQ(data::publishedSnapshot(inst).get(), before); // nothing published mid-batch
+    }
+    auto snap = data::publishedSnapshot(inst);
+    EXPECT_EQ(snap->generation, inst.generation);
+    EXPECT_EQ(snap->bytes, (std::vector<uint8_t>{1, 2, 3}));
+
+    // With no reader holding it, the retired snapshot is refilled by the next-but-one publish.
+    const auto* current = snap.get();
+    snap.reset();
+    data::clearElement(inst, 0);
+    data::clearElement(inst, 1);
+    EXPECT_EQ(data::publishedSnapshot(inst).get(), current);
+
+    // A snapshot a reader still holds is never overwritten.
+    auto held = data::publishedSnapshot(inst);
+    data::clearElement(inst, 2);
+    data::zeroAllElements(inst);
+    EXPECT_EQ(held->bytes, (std::vector<uint8_t>{0, 0, 3}));
+    EXPECT_NE(data::publishedSnapshot(inst).get(), held.get());
+}
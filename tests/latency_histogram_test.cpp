@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include "latency_histogram.hpp"
+
+using trdp_sim::util::LatencyHistogram;
+
+TEST(LatencyHistogramTest, ReportsPercentilesWithinBucketPrecision)
+{
+    LatencyHistogram hist;
+    for (uint64_t v = 1; v <= 1000; ++v)
+        hist.record(v);
+    hist.record(250000); // a single outlier only shows up in the tail
+
+    auto snap = hist.snapshot();
+    EXPECT_EQ(snap.samples, 1001u);
+    EXPECT_EQ(snap.maxUs, 250000u);
+    EXPECT_NEAR(snap.percentile(0.50), 500.0, 500.0 * 0.07);
+    EXPECT_NEAR(snap.percentile(0.99), 990.0, 990.0 * 0.07);
+    EXPECT_DOUBLE_EQ(snap.percentile(1.0), 250000.0);
+
+    // Merging two histograms is the same as recording into one.
+    LatencyHistogram other;
+    for (int i = 0; i < 1001; ++i)
+        other.record(8);
+    snap.merge(other.snapshot());
+    EXPECT_EQ(snap.samples, 2002u);
+    EXPECT_DOUBLE_EQ(snap.percentile(0.25), 8.0);
+}
+
+TEST(LatencyHistogramTest, BucketsCoverTheWholeRange)
+{
+    for (uint64_t v : {0ull, 15ull, 16ull, 17ull, 1000ull, 123456ull, (1ull << 31) + 5})
+    {
+        const auto idx = LatencyHistogram::bucketFor(v);
+        ASSERT_LT(idx, LatencyHistogram::kBuckets);
+        EXPECT_GE(LatencyHistogram::bucketUpperBound(idx), v);
+        if (idx > 0)
+        {
+            EXPECT_LT(LatencyHistogram::bucketUpperBound(idx - 1), v);
+        }
+    }
+    EXPECT_EQ(LatencyHistogram::bucketFor(~0ull), LatencyHistogram::kBuckets - 1);
+}
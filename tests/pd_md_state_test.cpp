@@ -1,13 +1,17 @@
 #include <gtest/gtest.h>
 
+#include "backend_engine.hpp"
 #include "config_manager.hpp"
+#include "diagnostic_manager.hpp"
 #include "md_engine.hpp"
 #include "pd_engine.hpp"
 #include "trdp_adapter.hpp"
 
 #include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <mutex>
+#include <optional>
 #include <thread>
 
 namespace
@@ -79,6 +83,163 @@ TEST_F(PdMdStateTest, PdReceiveUpdatesDataset)
     EXPECT_EQ(ds->values[1].raw[0], 'T');
 }
 
+TEST(PdRawPayload, UnmarshalledTelegramKeepsTheWholeFrame)
+{
+    auto ctx = buildContextFromConfig();
+    for (auto& tel : ctx->deviceConfig.interfaces[0].telegrams)
+    {
+        if (tel.comId == 3001)
+            tel.pdParam->marshall = false;
+    }
+
+    trdp_sim::trdp::TrdpAdapter adapter(*ctx);
+    engine::pd::PdEngine        pd(*ctx, adapter);
+    engine::md::MdEngine        md(*ctx, adapter);
+    diag::DiagnosticManager     diagMgr(*ctx, pd, md, adapter, {}, {});
+    trdp_sim::BackendEngine     backend(*ctx, pd, md, diagMgr);
+    ctx->pdEngine    = &pd;
+    ctx->mdEngine    = &md;
+    ctx->diagManager = &diagMgr;
+    backend.applyPreloadedConfiguration(ctx->deviceConfig);
+
+    auto* ds = pd.getDataSetInstance(3);
+    ASSERT_NE(ds, nullptr);
+    const std::vector<uint8_t> frame{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    adapter.handlePdCallback(3001, frame.data(), frame.size());
+
+    std::lock_guard<std::mutex> lk(ds->mtx);
+    EXPECT_FALSE(ds->contiguous);
+    EXPECT_EQ(data::elementBytes(*ds, 0), frame);
+}
+
+TEST_F(PdMdStateTest, PdReceiveDispatchesOnlyIndexedSubscribers)
+{
+    auto subs = ctx->pdSubscribersByComId.find(3001);
+    ASSERT_NE(subs, ctx->pdSubscribersByComId.end());
+    ASSERT_EQ(subs->second.size(), 1u);
+    auto* sub = subs->second.front();
+
+    const std::array<uint8_t, 8> payload{1, 0, 0, 0, 'T', 'E', 'S', 'T'};
+    adapter.handlePdCallback(9999, payload.data(), payload.size());
+    adapter.handlePdCallback(3001, payload.data(), payload.size());
+
+    std::lock_guard<std::mutex> lk(sub->mtx);
+    EXPECT_EQ(sub->stats.rxCount, 1u);
+}
+
+TEST_F(PdMdStateTest, PdReceiveIsHandedToTheRxWorkerWhileRunning)
+{
+    auto* sub = ctx->pdSubscribersByComId.at(3001).front();
+    pdEngine.start();
+
+    const std::array<uint8_t, 8> payload{1, 0, 0, 0, 'T', 'E', 'S', 'T'};
+    adapter.handlePdCallback(3001, payload.data(), payload.size());
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    uint64_t   rxCount  = 0;
+    while (rxCount == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        {
+            std::lock_guard<std::mutex> lk(sub->mtx);
+            rxCount = sub->stats.rxCount;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(rxCount, 1u);
+
+    const auto rx = pdEngine.rxStats();
+    ASSERT_FALSE(rx.empty());
+    EXPECT_EQ(rx.front().ring.pushed, 1u);
+    EXPECT_EQ(rx.front().ring.overflows, 0u);
+    EXPECT_EQ(rx.front().ring.occupancy, 0u);
+}
+
+TEST_F(PdMdStateTest, PdMailboxCoalescesFramesUntilRead)
+{
+    engine::pd::PdRxConfig rx = pdEngine.rxConfig();
+    rx.decodeRateHz           = 0.1; // one decode per 10 s
+    pdEngine.setRxConfig(rx);
+
+    auto* sub = ctx->pdSubscribersByComId.at(3001).front();
+    auto* ds  = sub->dataset;
+    for (uint8_t tag : {'A', 'B', 'C'})
+    {
+        const std::array<uint8_t, 8> payload{1, 0, 0, 0, tag, 'E', 'S', 'T'};
+        adapter.handlePdCallback(3001, payload.data(), payload.size());
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(sub->mtx);
+        EXPECT_EQ(sub->stats.rxCount, 3u);
+        EXPECT_EQ(sub->stats.decodes, 1u);
+        EXPECT_EQ(sub->stats.coalescedFrames, 1u);
+    }
+    {
+        std::lock_guard<std::mutex> lk(ds->mtx);
+        EXPECT_EQ(ds->values[1].raw[0], 'A');
+    }
+
+    // Reading the dataset decodes the newest frame.
+    ASSERT_EQ(pdEngine.getDataSetInstance(3), ds);
+    {
+        std::lock_guard<std::mutex> lk(ds->mtx);
+        EXPECT_EQ(ds->values[1].raw[0], 'C');
+    }
+    std::lock_guard<std::mutex> lk(sub->mtx);
+    EXPECT_EQ(sub->stats.decodes, 2u);
+    EXPECT_FALSE(sub->mailboxPending);
+}
+
+TEST_F(PdMdStateTest, PdMailboxIsDecodedOnceTheIntervalPassesWithoutTraffic)
+{
+    engine::pd::PdRxConfig rx = pdEngine.rxConfig();
+    rx.decodeRateHz           = 20.0; // one decode per 50 ms
+    pdEngine.setRxConfig(rx);
+
+    auto*      sub    = ctx->pdSubscribersByComId.at(3001).front();
+    auto*      ds     = sub->dataset;
+    const auto rxTime = std::chrono::steady_clock::now();
+    for (uint8_t tag : {'A', 'B'})
+    {
+        const std::array<uint8_t, 8> payload{1, 0, 0, 0, tag, 'E', 'S', 'T'};
+        adapter.handlePdCallback(3001, payload.data(), payload.size());
+    }
+
+    // No further frame and no syncDataSet(): the shard pass decodes the held frame.
+    pdEngine.processPublishersOnce(rxTime + std::chrono::milliseconds(60));
+    {
+        std::lock_guard<std::mutex> lk(sub->mtx);
+        EXPECT_EQ(sub->stats.decodes, 2u);
+        EXPECT_FALSE(sub->mailboxPending);
+    }
+    std::lock_guard<std::mutex> lk(ds->mtx);
+    EXPECT_EQ(ds->values[1].raw[0], 'B');
+}
+
+TEST_F(PdMdStateTest, PdSubscriberTimeoutFiresFromDeadline)
+{
+    auto* sub = ctx->pdSubscribersByComId.at(3001).front();
+
+    const std::array<uint8_t, 8> payload{1, 0, 0, 0, 'T', 'E', 'S', 'T'};
+    const auto                   rxTime = std::chrono::steady_clock::now();
+    adapter.handlePdCallback(3001, payload.data(), payload.size());
+
+    // timeoutUs is 120 ms for COM ID 3001.
+    pdEngine.processPublishersOnce(rxTime + std::chrono::milliseconds(100));
+    {
+        std::lock_guard<std::mutex> lk(sub->mtx);
+        EXPECT_FALSE(sub->stats.timedOut);
+    }
+
+    pdEngine.processPublishersOnce(rxTime + std::chrono::milliseconds(200));
+    {
+        std::lock_guard<std::mutex> lk(sub->mtx);
+        EXPECT_TRUE(sub->stats.timedOut);
+        EXPECT_EQ(sub->stats.timeoutCount, 1u);
+        EXPECT_FALSE(sub->timeoutArmed);
+    }
+}
+
 TEST_F(PdMdStateTest, MdSessionTimesOutAndTracksRetries)
 {
     mdEngine.start();
@@ -121,3 +282,118 @@ TEST_F(PdMdStateTest, MdSessionTimesOutAndTracksRetries)
         EXPECT_GE(session->stats.rxCount, 1u);
     }
 }
+
+TEST_F(PdMdStateTest, MdRepliesResolveByTheLatestRequestUuid)
+{
+    auto sessionId = mdEngine.createRequestSession(2001);
+    ASSERT_NE(sessionId, 0u);
+    auto* session = *mdEngine.getSession(sessionId);
+
+    mdEngine.sendRequest(sessionId);
+    TRDP_UUID_T firstUuid{};
+    {
+        std::lock_guard<std::mutex> lk(session->mtx);
+        firstUuid = session->trdpSessionId;
+    }
+    mdEngine.sendRequest(sessionId);
+    TRDP_UUID_T secondUuid{};
+    {
+        std::lock_guard<std::mutex> lk(session->mtx);
+        secondUuid = session->trdpSessionId;
+    }
+    ASSERT_NE(std::memcmp(&firstUuid, &secondUuid, sizeof(TRDP_UUID_T)), 0);
+
+    // A reply to the superseded request no longer matches the session.
+    const std::array<uint8_t, 2> reply{0xAA, 0xBB};
+    TRDP_MD_INFO_T               stale{};
+    stale.sessionId = firstUuid;
+    adapter.handleMdCallback(&stale, reply.data(), reply.size());
+    {
+        std::lock_guard<std::mutex> lk(session->mtx);
+        EXPECT_EQ(session->stats.rxCount, 0u);
+        EXPECT_EQ(session->state, engine::md::MdSessionState::WAITING_REPLY);
+    }
+
+    TRDP_MD_INFO_T current{};
+    current.sessionId = secondUuid;
+    current.comId     = 2001;
+    adapter.handleMdCallback(&current, reply.data(), reply.size());
+    std::lock_guard<std::mutex> lk(session->mtx);
+    EXPECT_EQ(session->stats.rxCount, 1u);
+    EXPECT_EQ(session->state, engine::md::MdSessionState::REPLY_RECEIVED);
+}
+
+TEST_F(PdMdStateTest, MdRetryAndTimeoutFireOnTheirDeadlines)
+{
+    mdEngine.start();
+    auto sessionId = mdEngine.createRequestSession(2001);
+    ASSERT_NE(sessionId, 0u);
+    auto* session = *mdEngine.getSession(sessionId);
+
+    // replyTimeoutUs is 40 ms with one retry for COM ID 2001.
+    const auto sent = std::chrono::steady_clock::now();
+    mdEngine.sendRequest(sessionId);
+
+    std::optional<std::chrono::steady_clock::duration> retryAt;
+    std::optional<std::chrono::steady_clock::duration> timeoutAt;
+    while (!timeoutAt && std::chrono::steady_clock::now() - sent < std::chrono::seconds(1))
+    {
+        {
+            std::lock_guard<std::mutex> lk(session->mtx);
+            const auto                  elapsed = std::chrono::steady_clock::now() - sent;
+            if (!retryAt && session->stats.retryCount > 0)
+                retryAt = elapsed;
+            if (session->state == engine::md::MdSessionState::TIMEOUT)
+                timeoutAt = elapsed;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+
+    ASSERT_TRUE(retryAt.has_value());
+    ASSERT_TRUE(timeoutAt.has_value());
+    EXPECT_GE(*retryAt, std::chrono::milliseconds(40));
+    EXPECT_LT(*retryAt, std::chrono::milliseconds(50));
+    EXPECT_GE(*timeoutAt, std::chrono::milliseconds(80));
+    EXPECT_LT(*timeoutAt, std::chrono::milliseconds(95));
+}
+
+TEST_F(PdMdStateTest, MdTcpPacingDefersTheDispatchInsteadOfSleeping)
+{
+    mdEngine.start();
+    auto sessionId = mdEngine.createRequestSession(2001);
+    ASSERT_NE(sessionId, 0u);
+    auto* session = *mdEngine.getSession(sessionId);
+    {
+        std::lock_guard<std::mutex> lk(session->mtx);
+        session->proto = engine::md::MdProtocol::TCP;
+    }
+
+    mdEngine.sendRequest(sessionId);
+    const auto start = std::chrono::steady_clock::now();
+    mdEngine.sendRequest(sessionId); // inside the 50 ms TCP pacing interval
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+    {
+        std::lock_guard<std::mutex> lk(session->mtx);
+        EXPECT_EQ(session->stats.txCount, 1u);
+        EXPECT_EQ(session->stats.pacedDispatches, 1u);
+        EXPECT_EQ(session->pendingDispatch, engine::md::MdPendingDispatch::REQUEST);
+        EXPECT_EQ(session->state, engine::md::MdSessionState::REQUEST_SENT);
+    }
+
+    // The MD thread sends it once the interval has passed.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    uint64_t   txCount  = 0;
+    while (txCount < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        {
+            std::lock_guard<std::mutex> lk(session->mtx);
+            txCount = session->stats.txCount;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(txCount, 2u);
+    std::lock_guard<std::mutex> lk(session->mtx);
+    EXPECT_EQ(session->pendingDispatch, engine::md::MdPendingDispatch::NONE);
+    EXPECT_EQ(session->state, engine::md::MdSessionState::WAITING_REPLY);
+}
@@ -18,10 +18,11 @@ namespace
         const std::string path = std::filesystem::temp_directory_path() / "pd_sched.xml";
         std::ofstream     ofs(path);
         ofs << "<Device hostName=\"sched\">"
+               "<ComParameters><ComParameter id=\"1\" qos=\"3\" ttl=\"32\"/></ComParameters>"
                "<DataSets><DataSet name=\"ds\" id=\"1\"><Element name=\"raw\" type=\"UINT8\"/></DataSet></DataSets>"
                "<Interfaces><Interface networkId=\"1\" name=\"if1\">"
                "<PdCom port=\"17224\" qos=\"1\" ttl=\"1\" timeoutUs=\"5000\" validityBehavior=\"ZERO\"/>"
-               "<MdCom udpPort=\"17225\" tcpPort=\"17226\"/>"
+               "<MdCom udpPort=\"17225\" tcpPort=\"17226\" replyTimeoutUs=\"100000\" confirmTimeoutUs=\"100000\"/>"
                "<Telegrams>"
                "<Telegram name=\"Fast\" comId=\"100\" dataSetId=\"1\" comParameterId=\"1\">"
                "<PdParameters cycleUs=\"2000\" marshall=\"false\" timeoutUs=\"8000\" validityBehavior=\"KEEP\" redundant=\"1\"/>"
@@ -130,3 +131,285 @@ TEST_F(PdSchedulingTest, RedundantSendDropsChannelButContinues)
         EXPECT_FALSE(pdPtr->stats.lastTxTime.time_since_epoch().count() == 0);
     }
 }
+
+TEST_F(PdSchedulingTest, SkipsPublishersUntilDeadlineOrTrigger)
+{
+    auto now = std::chrono::steady_clock::now();
+    engine.processPublishersOnce(now);
+    const auto firstRound = adapter.getPdSendLog().size();
+    ASSERT_GE(firstRound, 2u);
+
+    // Nothing is due again within the same cycle.
+    engine.processPublishersOnce(now + std::chrono::microseconds(10));
+    EXPECT_EQ(adapter.getPdSendLog().size(), firstRound);
+
+    engine.triggerSendNow(101);
+    engine.processPublishersOnce(now + std::chrono::microseconds(20));
+    const auto log = adapter.getPdSendLog();
+    ASSERT_GT(log.size(), firstRound);
+    EXPECT_EQ(log.back().comId, 101u);
+}
+
+TEST_F(PdSchedulingTest, AbsoluteModeKeepsPhaseAndCountsMissedCycles)
+{
+    engine::pd::PdTimingConfig timing{};
+    timing.mode    = engine::pd::PdTimingConfig::CycleMode::ABSOLUTE;
+    timing.catchUp = engine::pd::PdTimingConfig::CatchUpPolicy::SKIP;
+    engine.setTimingConfig(timing);
+
+    engine::pd::PdTelegramRuntime* fast{nullptr};
+    for (auto& pdPtr : ctx->pdTelegrams)
+        if (pdPtr && pdPtr->cfg && pdPtr->cfg->comId == 100u)
+            fast = pdPtr.get();
+    ASSERT_NE(fast, nullptr);
+
+    std::chrono::steady_clock::time_point anchor;
+    {
+        std::lock_guard<std::mutex> lk(fast->mtx);
+        anchor = fast->nextDue;
+    }
+
+    // Sent 500 us late: the next slot stays on the original 2 ms grid.
+    engine.processPublishersOnce(anchor + std::chrono::microseconds(500));
+    {
+        std::lock_guard<std::mutex> lk(fast->mtx);
+        EXPECT_EQ(fast->nextDue, anchor + std::chrono::microseconds(2000));
+        EXPECT_EQ(fast->stats.missedCycles, 0u);
+        EXPECT_GE(fast->stats.maxLatenessUs, 500.0);
+    }
+
+    // Overrun by more than two cycles: the passed slots are skipped and counted.
+    engine.processPublishersOnce(anchor + std::chrono::microseconds(6500));
+    {
+        std::lock_guard<std::mutex> lk(fast->mtx);
+        EXPECT_EQ(fast->stats.missedCycles, 2u);
+        EXPECT_EQ(fast->nextDue, anchor + std::chrono::microseconds(8000));
+    }
+}
+
+TEST_F(PdSchedulingTest, RealtimeModeReportsWakeupLatency)
+{
+    engine::pd::PdRealtimeConfig rt{};
+    rt.enabled    = true;
+    rt.lockMemory = false;
+    engine.setRealtimeConfig(rt);
+
+    // Without CAP_SYS_NICE the thread falls back to normal scheduling but still runs.
+    engine.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    engine.stop();
+
+    const auto stats = engine.wakeupStats();
+    EXPECT_GT(stats.samples, 0u);
+    EXPECT_GE(stats.maxUs, stats.meanUs);
+    EXPECT_FALSE(adapter.getPdSendLog().empty());
+}
+
+TEST_F(PdSchedulingTest, ShardsPublishersAcrossWorkers)
+{
+    engine::pd::PdShardingConfig sharding{};
+    sharding.partition = engine::pd::PdShardingConfig::Partition::COMID_HASH;
+    sharding.workers   = 2;
+    engine.setShardingConfig(sharding);
+    engine.initializeFromConfig();
+
+    auto shards = engine.shardStats();
+    ASSERT_EQ(shards.size(), 2u);
+    EXPECT_EQ(shards[0].publishers + shards[1].publishers, 2u);
+
+    engine.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    engine.stop();
+
+    uint64_t sends{0};
+    for (const auto& shard : engine.shardStats())
+        sends += shard.sends;
+    EXPECT_GE(sends, 2u);
+}
+
+TEST_F(PdSchedulingTest, ReusesPayloadUntilDatasetChanges)
+{
+    engine::pd::PdTelegramRuntime* fast{nullptr};
+    for (auto& pdPtr : ctx->pdTelegrams)
+        if (pdPtr && pdPtr->cfg && pdPtr->cfg->comId == 100u)
+            fast = pdPtr.get();
+    ASSERT_NE(fast, nullptr);
+
+    auto now = std::chrono::steady_clock::now();
+    engine.processPublishersOnce(now);
+    engine.processPublishersOnce(now + std::chrono::microseconds(2000));
+    {
+        std::lock_guard<std::mutex> lk(fast->mtx);
+        EXPECT_EQ(fast->stats.payloadCacheMisses, 1u);
+        EXPECT_EQ(fast->stats.payloadCacheHits, 1u);
+    }
+
+    auto* ds = engine.getDataSetInstance(1);
+    ASSERT_NE(ds, nullptr);
+    {
+        const uint8_t value = 0x5A;
+        std::lock_guard<std::mutex> lk(ds->mtx);
+        data::setElementBytes(*ds, 0, &value, 1);
+    }
+
+    engine.processPublishersOnce(now + std::chrono::microseconds(4000));
+    std::lock_guard<std::mutex> lk(fast->mtx);
+    EXPECT_EQ(fast->stats.payloadCacheMisses, 2u);
+    ASSERT_EQ(fast->cachedPayload.size(), 1u);
+    EXPECT_EQ(fast->cachedPayload[0], 0x5A);
+}
+
+TEST_F(PdSchedulingTest, PicksUpRepublishedInjectionRules)
+{
+    auto now = std::chrono::steady_clock::now();
+    engine.processPublishersOnce(now);
+    const auto baseline = adapter.getPdSendLog().size();
+    ASSERT_GE(baseline, 2u);
+
+    trdp_sim::SimulationControls::InjectionRuleSet rules;
+    rules.pdRules[100].lossRate = 1.0;
+    {
+        std::lock_guard<std::mutex> lk(ctx->simulation.mtx);
+        ctx->simulation.publishInjectionRules(std::move(rules));
+    }
+
+    // Both telegrams are due again; only the one without a drop rule goes out.
+    engine.processPublishersOnce(now + std::chrono::microseconds(4000));
+    auto log = adapter.getPdSendLog();
+    ASSERT_GT(log.size(), baseline);
+    for (auto i = baseline; i < log.size(); ++i)
+        EXPECT_EQ(log[i].comId, 101u);
+
+    {
+        std::lock_guard<std::mutex> lk(ctx->simulation.mtx);
+        ctx->simulation.publishInjectionRules({});
+    }
+    const auto beforeClear = log.size();
+    engine.processPublishersOnce(now + std::chrono::microseconds(5000));
+    log = adapter.getPdSendLog();
+    ASSERT_GT(log.size(), beforeClear);
+    EXPECT_EQ(log[beforeClear].comId, 100u);
+}
+
+TEST_F(PdSchedulingTest, DelayRuleHoldsBackOnlyTheTargetedTelegram)
+{
+    trdp_sim::SimulationControls::InjectionRuleSet rules;
+    rules.pdRules[100].delayMs = 100;
+    {
+        std::lock_guard<std::mutex> lk(ctx->simulation.mtx);
+        ctx->simulation.publishInjectionRules(std::move(rules));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    engine.processPublishersOnce(start);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+
+    auto log = adapter.getPdSendLog();
+    ASSERT_FALSE(log.empty());
+    for (const auto& entry : log)
+        EXPECT_EQ(entry.comId, 101u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    log = adapter.getPdSendLog();
+    EXPECT_EQ(log.back().comId, 100u);
+}
+
+TEST_F(PdSchedulingTest, RateTargetPacesStressTrafficEvenly)
+{
+    auto rates                 = std::make_shared<trdp_sim::SimulationControls::PdRateTargets>();
+    rates->perComId[100]       = 250.0; // one send every 4 ms instead of the 2 ms cycle
+    {
+        std::lock_guard<std::mutex> lk(ctx->simulation.mtx);
+        ctx->simulation.stress.enabled = true;
+        ctx->simulation.stress.pdRates = rates;
+    }
+
+    const auto countFast = [this]()
+    {
+        std::size_t n = 0;
+        for (const auto& entry : adapter.getPdSendLog())
+            n += entry.comId == 100u ? 1 : 0;
+        return n;
+    };
+
+    // Tick every millisecond; COM ID 100 must only go out on its 4 ms token boundaries.
+    const auto       start = std::chrono::steady_clock::now();
+    std::vector<int> sentAt;
+    for (int ms = 0; ms <= 12; ++ms)
+    {
+        const auto before = countFast();
+        engine.processPublishersOnce(start + std::chrono::milliseconds(ms));
+        if (countFast() > before)
+            sentAt.push_back(ms);
+    }
+    EXPECT_EQ(sentAt, (std::vector<int>{0, 4, 8, 12}));
+
+    const auto stats = engine.rateStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats.front().comId, 100u);
+    EXPECT_DOUBLE_EQ(stats.front().targetPerSecond, 250.0);
+    EXPECT_GT(stats.front().achievedPerSecond, 0.0);
+}
+
+TEST(PdTokenBucketTest, LateWakeupsKeepTheTargetRate)
+{
+    using Clock = engine::pd::PdScheduler::Clock;
+    engine::pd::PdTokenBucket bucket;
+    const auto                start = Clock::now();
+    bucket.configure(10000.0, start); // 100 us interval
+
+    // Every wakeup lands 50 us after the release it was armed for.
+    std::size_t sent = 0;
+    auto        now  = start;
+    const auto  end  = start + std::chrono::seconds(1);
+    while (now < end)
+    {
+        if (bucket.tryConsume(now))
+            ++sent;
+        now = bucket.nextRelease(now) + std::chrono::microseconds(50);
+    }
+    EXPECT_NEAR(static_cast<double>(sent), 10000.0, 10.0);
+
+    // A long stall is not repaid as a burst: only one release is due afterwards.
+    now += std::chrono::milliseconds(10);
+    EXPECT_TRUE(bucket.tryConsume(now));
+    EXPECT_FALSE(bucket.tryConsume(now));
+}
+
+TEST_F(PdSchedulingTest, StaggersPublishersSharingACycle)
+{
+    // Give both telegrams the same 2 ms cycle.
+    for (auto& iface : ctx->deviceConfig.interfaces)
+        for (auto& tel : iface.telegrams)
+            if (tel.pdParam)
+                tel.pdParam->cycleUs = 2000;
+
+    const auto nextDueOf = [this](uint32_t comId)
+    {
+        for (auto& pdPtr : ctx->pdTelegrams)
+            if (pdPtr && pdPtr->cfg && pdPtr->cfg->comId == comId)
+            {
+                std::lock_guard<std::mutex> lk(pdPtr->mtx);
+                return pdPtr->nextDue;
+            }
+        return std::chrono::steady_clock::time_point{};
+    };
+
+    engine.initializeFromConfig();
+    const auto first = nextDueOf(100);
+    EXPECT_EQ(nextDueOf(101) - first, std::chrono::microseconds(1000));
+
+    // Each tick carries a single telegram instead of the whole group.
+    engine.processPublishersOnce(first);
+    engine.processPublishersOnce(first + std::chrono::microseconds(1000));
+    engine.processPublishersOnce(first + std::chrono::microseconds(2000));
+    const auto shards = engine.shardStats();
+    ASSERT_EQ(shards.size(), 1u);
+    EXPECT_EQ(shards.front().maxSendsPerPass, 1u);
+
+    auto timing    = engine.timingConfig();
+    timing.phasing = engine::pd::PdTimingConfig::Phasing::ALIGNED;
+    engine.setTimingConfig(timing);
+    engine.initializeFromConfig();
+    EXPECT_EQ(nextDueOf(100), nextDueOf(101));
+}
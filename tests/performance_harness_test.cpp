@@ -2,6 +2,7 @@
 
 #include "config_manager.hpp"
 #include "data_marshalling.hpp"
+#include "pd_engine.hpp"
 #include "performance_harness.hpp"
 #include "trdp_adapter.hpp"
 
@@ -62,6 +63,54 @@ TEST(PerformanceHarnessTest, MeetsPdMdAndWebUiThresholds)
     EXPECT_FALSE(report.toJson().empty());
 }
 
+TEST(PerformanceHarnessTest, PdSaturationRampReportsPerInterfaceCapacity)
+{
+    auto                        ctx = buildContextFromConfig();
+    trdp_sim::trdp::TrdpAdapter adapter(*ctx);
+    engine::pd::PdEngine        pd(*ctx, adapter);
+    ctx->pdEngine = &pd;
+    pd.initializeFromConfig();
+
+    trdp_sim::perf::SaturationConfig cfg{};
+    cfg.settleTime   = std::chrono::milliseconds(10);
+    cfg.stepDuration = std::chrono::milliseconds(40);
+    cfg.maxSteps     = 4;
+    cfg.thresholds.jitterVmMicros = 1e9; // only the delivery ratio can end the ramp here
+
+    // The probe must not reset the live lateness metric.
+    auto* publisher = ctx->pdTelegrams.front().get();
+    for (auto& rt : ctx->pdTelegrams)
+    {
+        if (rt->direction == engine::pd::Direction::PUBLISH)
+            publisher = rt.get();
+    }
+    {
+        std::lock_guard<std::mutex> lk(publisher->mtx);
+        publisher->stats.maxLatenessUs = 1e9;
+    }
+
+    // Only the shape of the report is checked; what the ramp sustains depends on the host.
+    const auto report = trdp_sim::perf::runPdSaturation(*ctx, pd, cfg);
+    ASSERT_EQ(report.interfaces.size(), 1u);
+    const auto& iface = report.interfaces.front();
+    EXPECT_EQ(iface.name, "if1");
+    EXPECT_EQ(iface.publishers, 1u);
+    ASSERT_FALSE(iface.steps.empty());
+    EXPECT_LE(iface.steps.size(), cfg.maxSteps);
+    EXPECT_GT(iface.steps.front().offeredPerSecond, 10.0);
+    for (std::size_t i = 1; i < iface.steps.size(); ++i)
+        EXPECT_GE(iface.steps[i].offeredPerSecond, iface.steps[i - 1].offeredPerSecond);
+    EXPECT_FALSE(pd.isRunning());
+    {
+        std::lock_guard<std::mutex> lk(publisher->mtx);
+        EXPECT_GE(publisher->stats.maxLatenessUs, 1e9);
+    }
+    EXPECT_NE(report.toJson().find("\"maxSustainablePerSecond\""), std::string::npos);
+
+    std::lock_guard<std::mutex> lk(ctx->simulation.mtx);
+    EXPECT_FALSE(ctx->simulation.stress.enabled);
+}
+
 TEST(ResilienceTest, RecoversMulticastAfterInterfaceReset)
 {
     auto ctx = buildContextFromConfig();
@@ -97,19 +97,35 @@ TEST(SecurityValidation, MdTcpDispatchIsRateLimited)
     auto sessionId = md.createRequestSession(2001);
     ASSERT_NE(sessionId, 0u);
 
-    auto begin = std::chrono::steady_clock::now();
     md.sendRequest(sessionId);
 
     auto opt = md.getSession(sessionId);
     ASSERT_TRUE(opt.has_value());
+    std::chrono::steady_clock::time_point firstTx;
     {
         std::lock_guard<std::mutex> lk((*opt)->mtx);
         (*opt)->state = engine::md::MdSessionState::IDLE;
         (*opt)->proto = engine::md::MdProtocol::TCP;
+        firstTx       = (*opt)->stats.lastTxTime;
     }
+    auto begin = std::chrono::steady_clock::now();
     md.sendRequest(sessionId);
+    // The paced request is queued rather than slept on.
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(50));
 
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now() - begin);
-    EXPECT_GE(elapsed.count(), 50);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    uint64_t   txCount  = 0;
+    std::chrono::steady_clock::time_point secondTx;
+    while (txCount < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        {
+            std::lock_guard<std::mutex> lk((*opt)->mtx);
+            txCount  = (*opt)->stats.txCount;
+            secondTx = (*opt)->stats.lastTxTime;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(txCount, 2u);
+    auto spacing = std::chrono::duration_cast<std::chrono::milliseconds>(secondTx - firstTx);
+    EXPECT_GE(spacing.count(), 50);
 }
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "spsc_frame_ring.hpp"
+
+#include <thread>
+#include <vector>
+
+using trdp_sim::util::SpscFrameRing;
+
+TEST(SpscFrameRingTest, CountsOverflowsAndDrainsInOrder)
+{
+    SpscFrameRing ring(3); // rounded up to 4
+    const auto    now = SpscFrameRing::Clock::now();
+    for (uint8_t i = 0; i < 6; ++i)
+        ring.tryPush(100 + i, &i, 1, now);
+
+    auto stats = ring.stats();
+    EXPECT_EQ(stats.capacity, 4u);
+    EXPECT_EQ(stats.occupancy, 4u);
+    EXPECT_EQ(stats.highWater, 4u);
+    EXPECT_EQ(stats.pushed, 4u);
+    EXPECT_EQ(stats.overflows, 2u);
+
+    std::vector<uint32_t> comIds;
+    EXPECT_EQ(ring.drain([&](const SpscFrameRing::Frame& f) { comIds.push_back(f.comId); }), 4u);
+    EXPECT_EQ(comIds, (std::vector<uint32_t>{100, 101, 102, 103}));
+    EXPECT_TRUE(ring.empty());
+
+    const std::vector<uint8_t> tooLarge(SpscFrameRing::kMaxFrameBytes + 1, 0);
+    EXPECT_FALSE(ring.tryPush(1, tooLarge.data(), tooLarge.size(), now));
+    EXPECT_EQ(ring.stats().overflows, 2u);
+}
+
+TEST(SpscFrameRingTest, HandsFramesAcrossThreadsWithoutLoss)
+{
+    SpscFrameRing  ring(64);
+    constexpr int  kFrames = 20000;
+    std::thread    producer(
+        [&]()
+        {
+            for (uint32_t i = 0; i < kFrames; ++i)
+            {
+                const uint8_t byte = static_cast<uint8_t>(i);
+                while (!ring.tryPush(i, &byte, 1, SpscFrameRing::Clock::now()))
+                    std::this_thread::yield();
+            }
+        });
+
+    uint32_t expected = 0;
+    bool     ordered  = true;
+    while (expected < kFrames)
+    {
+        ring.drain(
+            [&](const SpscFrameRing::Frame& f)
+            {
+                ordered = ordered && f.comId == expected && f.data[0] == static_cast<uint8_t>(expected);
+                ++expected;
+            });
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(ring.stats().pushed, static_cast<uint64_t>(kFrames));
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "timer_wheel.hpp"
+
+#include <vector>
+
+using trdp_sim::util::TimerWheel;
+
+TEST(TimerWheelTest, FiresOnTheTickAfterTheDeadlineAndDropsReplacedTimers)
+{
+    const auto origin = TimerWheel::Clock::now();
+    TimerWheel wheel(std::chrono::microseconds(100), 8, origin); // one revolution is 800 us
+
+    wheel.schedule(1, origin + std::chrono::microseconds(250));
+    wheel.schedule(2, origin + std::chrono::microseconds(2050)); // two rounds later, same slot as id 1
+    wheel.schedule(3, origin + std::chrono::microseconds(500));
+    wheel.schedule(3, origin + std::chrono::microseconds(900)); // replaces the earlier timer
+    wheel.schedule(4, origin + std::chrono::microseconds(400));
+    wheel.cancel(4);
+    EXPECT_EQ(wheel.armedCount(), 3u);
+    EXPECT_EQ(wheel.nextExpiry(), origin + std::chrono::microseconds(300));
+
+    std::vector<uint64_t> fired;
+    wheel.expire(origin + std::chrono::microseconds(299), fired);
+    EXPECT_TRUE(fired.empty()); // never early
+    wheel.expire(origin + std::chrono::microseconds(300), fired);
+    EXPECT_EQ(fired, (std::vector<uint64_t>{1}));
+
+    fired.clear();
+    wheel.expire(origin + std::chrono::microseconds(1000), fired);
+    EXPECT_EQ(fired, (std::vector<uint64_t>{3}));
+    EXPECT_EQ(wheel.nextExpiry(), origin + std::chrono::microseconds(2100));
+
+    // A stall longer than a revolution still fires everything that is due.
+    fired.clear();
+    wheel.expire(origin + std::chrono::microseconds(5000), fired);
+    EXPECT_EQ(fired, (std::vector<uint64_t>{2}));
+    EXPECT_EQ(wheel.armedCount(), 0u);
+    EXPECT_FALSE(wheel.nextExpiry().has_value());
+}
+
+TEST(TimerWheelTest, NextExpiryTracksRearmedTimersBeyondOneRevolution)
+{
+    const auto origin = TimerWheel::Clock::now();
+    TimerWheel wheel(std::chrono::microseconds(100), 8, origin);
+
+    // Re-arming one id many times leaves a single live timer, several revolutions out.
+    for (int i = 0; i < 1000; ++i)
+        wheel.schedule(7, origin + std::chrono::microseconds(5000 + 100 * (i % 3)));
+    wheel.schedule(8, origin + std::chrono::microseconds(9000));
+    EXPECT_EQ(wheel.armedCount(), 2u);
+    EXPECT_EQ(wheel.nextExpiry(), origin + std::chrono::microseconds(5000)); // i = 999 -> +0
+
+    wheel.cancel(7);
+    EXPECT_EQ(wheel.nextExpiry(), origin + std::chrono::microseconds(9000));
+
+    std::vector<uint64_t> fired;
+    wheel.expire(origin + std::chrono::microseconds(9000), fired);
+    EXPECT_EQ(fired, (std::vector<uint64_t>{8}));
+    EXPECT_FALSE(wheel.nextExpiry().has_value());
+}
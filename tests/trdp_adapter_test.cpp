@@ -12,6 +12,8 @@
 #include <mutex>
 #include <thread>
 
+#include <unistd.h>
+
 namespace
 {
 
@@ -53,6 +55,141 @@ TEST(TrdpAdapterTest, RecordsErrorsWhenSendFails)
     EXPECT_EQ(adapter.getLastErrorCode().value(), 2u);
 }
 
+TEST(TrdpAdapterTest, SendRecorderKeepsTheLatestAttemptsInARing)
+{
+    trdp_sim::EngineContext     ctx;
+    trdp_sim::trdp::TrdpAdapter adapter(ctx);
+    engine::pd::PdTelegramRuntime pdRt{};
+
+    const std::array<uint8_t, 3> payload{1, 2, 3};
+    for (std::size_t i = 0; i < trdp_sim::trdp::PdSendRecorder::kCapacity + 10; ++i)
+        EXPECT_EQ(adapter.sendPdData(pdRt, payload.data(), payload.size()), 0);
+    EXPECT_EQ(adapter.getPdSendLog().size(), trdp_sim::trdp::PdSendRecorder::kCapacity);
+    EXPECT_EQ(adapter.getLastPdPayload(), std::vector<uint8_t>(payload.begin(), payload.end()));
+
+    // With the recorder off nothing is kept.
+    adapter.sendRecorder().setEnabled(false);
+    adapter.sendRecorder().clear();
+    EXPECT_EQ(adapter.sendPdData(pdRt, payload.data(), payload.size()), 0);
+    EXPECT_TRUE(adapter.getPdSendLog().empty());
+    EXPECT_TRUE(adapter.getLastPdPayload().empty());
+}
+
+TEST(TrdpAdapterTest, BatchSendReportsPerTelegramResults)
+{
+    trdp_sim::EngineContext     ctx;
+    trdp_sim::trdp::TrdpAdapter adapter(ctx);
+
+    std::array<engine::pd::PdTelegramRuntime, 3> runtimes{};
+    const std::array<uint8_t, 2>                 payload{0x10, 0x20};
+    std::array<trdp_sim::trdp::PdSendItem, 3>    items{};
+    for (std::size_t i = 0; i < items.size(); ++i)
+        items[i] = trdp_sim::trdp::PdSendItem{&runtimes[i], payload.data(), payload.size()};
+
+    EXPECT_EQ(adapter.sendPdBatch(items.data(), items.size()), 3u);
+    for (const auto& item : items)
+        EXPECT_EQ(item.result, 0);
+    EXPECT_EQ(adapter.getPdSendLog().size(), 3u);
+
+    adapter.setPdSendResult(-2);
+    EXPECT_EQ(adapter.sendPdBatch(items.data(), items.size()), 0u);
+    for (const auto& item : items)
+        EXPECT_EQ(item.result, -2);
+    EXPECT_EQ(adapter.getErrorCounters().pdSendErrors, 3u);
+}
+
+TEST(TrdpAdapterTest, EventLoopSleepsUntilReadinessTimeoutOrWake)
+{
+    trdp_sim::trdp::EventLoop loop;
+    ASSERT_TRUE(loop.valid());
+
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    loop.watch({fds[0]});
+
+    std::vector<int> ready;
+    auto             start = std::chrono::steady_clock::now();
+    EXPECT_EQ(loop.wait(std::chrono::milliseconds(20), ready), 0);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    ASSERT_EQ(::write(fds[1], "x", 1), 1);
+    EXPECT_EQ(loop.wait(std::chrono::seconds(5), ready), 1);
+    EXPECT_EQ(ready, std::vector<int>{fds[0]});
+
+    // The 5 s deadline is still armed; an earlier one must replace it.
+    char byte = 0;
+    ASSERT_EQ(::read(fds[0], &byte, 1), 1);
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(loop.wait(std::chrono::milliseconds(10), ready), 0);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    loop.watch({});
+
+    // The adapter's I/O thread idles without a timeout and exits promptly on stop.
+    trdp_sim::EngineContext     ctx;
+    trdp_sim::trdp::TrdpAdapter adapter(ctx);
+    std::thread                 io([&]() { adapter.runEventLoop(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    start = std::chrono::steady_clock::now();
+    adapter.stopEventLoop();
+    io.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(TrdpAdapterTest, EventLoopRewatchesAReusedDescriptor)
+{
+    trdp_sim::trdp::EventLoop loop;
+    ASSERT_TRUE(loop.valid());
+
+    int first[2];
+    ASSERT_EQ(::pipe(first), 0);
+    loop.watch({first[0]});
+
+    // The peer hangs up; the descriptor is handed to the stack, which closes it.
+    std::vector<int> ready;
+    ::close(first[1]);
+    EXPECT_EQ(loop.wait(std::chrono::seconds(5), ready), 1);
+    EXPECT_EQ(ready, std::vector<int>{first[0]});
+
+    // A new socket gets the same number and must be registered again.
+    int second[2];
+    ASSERT_EQ(::pipe(second), 0);
+    ASSERT_EQ(::dup2(second[0], first[0]), first[0]);
+    ::close(second[0]);
+    loop.watch({first[0]});
+
+    ASSERT_EQ(::write(second[1], "x", 1), 1);
+    EXPECT_EQ(loop.wait(std::chrono::seconds(5), ready), 1);
+    EXPECT_EQ(ready, std::vector<int>{first[0]});
+
+    loop.watch({});
+    for (int fd : {first[0], second[1]})
+        ::close(fd);
+}
+
+TEST(TrdpAdapterTest, OpensOneSessionPerInterface)
+{
+    trdp_sim::EngineContext ctx;
+    ctx.deviceConfig.interfaces.resize(2);
+    ctx.deviceConfig.interfaces[0].name = "busA";
+    ctx.deviceConfig.interfaces[1].name = "busB";
+    trdp_sim::trdp::TrdpAdapter adapter(ctx);
+
+    ASSERT_TRUE(adapter.init());
+    EXPECT_EQ(adapter.sessionCount(), 2u);
+    const auto busA = adapter.sessionFor(&ctx.deviceConfig.interfaces[0]);
+    const auto busB = adapter.sessionFor(&ctx.deviceConfig.interfaces[1]);
+    EXPECT_NE(busA, busB);
+    EXPECT_EQ(busA, ctx.trdpSession);
+    EXPECT_EQ(adapter.sessionFor(nullptr), ctx.trdpSession);
+
+    adapter.deinit();
+    EXPECT_EQ(adapter.sessionCount(), 0u);
+    EXPECT_EQ(ctx.trdpSession, nullptr);
+}
+
 class TrdpAdapterEngineHarness : public ::testing::Test
 {
   protected: